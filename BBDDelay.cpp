@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: BBDDelay.cpp
+  Description: Bucket-brigade (BBD) delay emulation for the flanger: clocked stage count, clock-rate
+  dependent sampling through polyphase input/output filters, analog filters and NE570-style companding
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#include "BBDDelay.h"
+
+// Zeroth order modified Bessel function (series), for the Kaiser window
+static double besselI0(double x)
+{
+	double sum = 1.0;
+	double term = 1.0;
+	for (int k = 1; k < 50; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+		if (term < sum * 1.0e-12)
+			break;
+	}
+	return sum;
+}
+
+BBDDelay::BBDDelay(void)
+{
+	filterTable.reset(new float[BBD_FILTER_HALF_TAPS * BBD_FILTER_PHASES + 2]);
+	buildFilterTable();
+}
+
+void BBDDelay::buildFilterTable()
+{
+	// Kaiser-windowed sinc at BBD_FILTER_CUTOFF of the (stretched) rate, one side only
+	const unsigned int points = BBD_FILTER_HALF_TAPS * BBD_FILTER_PHASES + 1;
+	const double i0Beta = besselI0(BBD_FILTER_KAISER_BETA);
+
+	for (unsigned int i = 0; i < points; i++)
+	{
+		double x = (double)i / BBD_FILTER_PHASES;
+		double arg = kPi * 2.0 * BBD_FILTER_CUTOFF * x;
+		double sinc = i == 0 ? 1.0 : sin(arg) / arg;
+
+		double ratio = x / BBD_FILTER_HALF_TAPS;
+		double window = besselI0(BBD_FILTER_KAISER_BETA * sqrt(fmax(0.0, 1.0 - ratio * ratio))) / i0Beta;
+
+		filterTable[i] = (float)(2.0 * BBD_FILTER_CUTOFF * sinc * window);
+	}
+
+	// --- guard point so filterTap( ) can interpolate at the very edge
+	filterTable[points] = 0.0f;
+}
+
+bool BBDDelay::reset(double _sampleRate, int channel)
+{
+	sampleRate = _sampleRate;
+
+	unsigned int stages = parameters.stages < 2 ? 2 : (parameters.stages > BBD_MAX_STAGES ? BBD_MAX_STAGES : parameters.stages);
+	bucketDelay = stages / 2;
+
+	// Input history covers the widest input kernel (slowest clock); the buffers only grow, so after the
+	// first reset (or one with the most stages) this only clears memory
+	unsigned int inputLength = nextPowerOfTwo((unsigned int)(2.0 * BBD_FILTER_HALF_TAPS / BBD_MIN_CLOCK_RATIO) + 4);
+	if (inputLength > inputCapacity)
+	{
+		inputBuffer.reset(new float[inputLength]);
+		inputCapacity = inputLength;
+	}
+	memset(&inputBuffer[0], 0, inputLength * sizeof(float));
+	inputMask = inputLength - 1;
+	inputIndex = 0;
+
+	// Tick history covers the register plus the widest output kernel (fastest clock)
+	unsigned int tickLength = nextPowerOfTwo(bucketDelay + (unsigned int)(2.0 * BBD_FILTER_HALF_TAPS * BBD_MAX_TICKS_PER_SAMPLE + BBD_MAX_TICKS_PER_SAMPLE) + 4);
+	if (tickLength > tickCapacity)
+	{
+		tickBuffer.reset(new float[tickLength]);
+		tickCapacity = tickLength;
+	}
+	memset(&tickBuffer[0], 0, tickLength * sizeof(float));
+	tickMask = tickLength - 1;
+	tickCount = 0;
+	tickPosition = 0.0;
+
+	// Analog filters around the BBD
+	inputFilter.reset(sampleRate, 0);
+	outputFilter.reset(sampleRate, 0);
+	AudioFilterParameters filterParams = inputFilter.getParameters();
+	filterParams.algorithm = filterAlgorithm::kButterLPF2;
+	filterParams.fc = (float)parameters.inputFilterFc;
+	inputFilter.setParameters(filterParams);
+	filterParams.fc = (float)parameters.outputFilterFc;
+	outputFilter.setParameters(filterParams);
+
+	// Compander envelopes, ~10 mSec (NE570 rectifier cap)
+	compressorEnvelope = 0.0;
+	expanderEnvelope = 0.0;
+	companderCoeff = exp(-1.0 / (0.010 * sampleRate));
+
+	updateClock();
+	return true;
+}
+
+void BBDDelay::setParameters(const BBDParameters& params)
+{
+	if (params.inputFilterFc != parameters.inputFilterFc)
+	{
+		AudioFilterParameters filterParams = inputFilter.getParameters();
+		filterParams.fc = (float)params.inputFilterFc;
+		inputFilter.setParameters(filterParams);
+	}
+	if (params.outputFilterFc != parameters.outputFilterFc)
+	{
+		AudioFilterParameters filterParams = outputFilter.getParameters();
+		filterParams.fc = (float)params.outputFilterFc;
+		outputFilter.setParameters(filterParams);
+	}
+
+	parameters = params;
+	updateClock();
+}
+
+void BBDDelay::setDelay_mSec(double delay_mSec)
+{
+	parameters.delay_mSec = delay_mSec;
+	updateClock();
+}
+
+double BBDDelay::getMinDelay_mSec()
+{
+	double fastest = BBD_MAX_TICKS_PER_SAMPLE * sampleRate;
+	return 1000.0 * (bucketDelay / fastest + 2.0 * BBD_FILTER_HALF_TAPS / sampleRate);
+}
+
+double BBDDelay::getMaxDelay_mSec()
+{
+	double slowest = BBD_MIN_CLOCK_RATIO * sampleRate;
+	return 1000.0 * (bucketDelay + 2.0 * BBD_FILTER_HALF_TAPS) / slowest;
+}
+
+void BBDDelay::updateClock()
+{
+	// Total delay = register (bucketDelay / fclock) + input and output kernel latency, which is
+	// BBD_FILTER_HALF_TAPS periods of the lower rate each: delay = M/f + 2W/min(fs, f)
+	double delay = parameters.delay_mSec / 1000.0;
+	double W2 = 2.0 * BBD_FILTER_HALF_TAPS;
+
+	double clock = (bucketDelay + W2) / delay;	// clock below the sample rate
+	if (clock > sampleRate)
+	{
+		double registerDelay = delay - W2 / sampleRate;
+		clock = registerDelay > 0.0 ? bucketDelay / registerDelay : BBD_MAX_TICKS_PER_SAMPLE * sampleRate;
+	}
+
+	clock = fmax(clock, BBD_MIN_CLOCK_RATIO * sampleRate);
+	clock = fmin(clock, BBD_MAX_TICKS_PER_SAMPLE * sampleRate);
+
+	clockRate = clock;
+	ticksPerSample = clockRate / sampleRate;
+}
+
+float BBDDelay::processAudioSample(float xn, int channel, double _sampleRate)
+{
+	const float W = (float)BBD_FILTER_HALF_TAPS;
+
+	// --- compressor (2:1) and anti-aliasing filter ahead of the BBD
+	double input = xn;
+	if (parameters.enableCompander)
+	{
+		compressorEnvelope = companderCoeff * compressorEnvelope + (1.0 - companderCoeff) * fabs(input);
+		input /= sqrt(fmax(compressorEnvelope, 1.0e-3));
+	}
+	input = inputFilter.processAudioSample((float)input, 0, sampleRate);
+
+	inputBuffer[inputIndex & inputMask] = (float)input;
+	const unsigned int newest = inputIndex++;
+
+	// Input resampler: kernel stretched to the clock when the clock is slower than the audio
+	const float rIn = ticksPerSample < 1.0 ? (float)ticksPerSample : 1.0f;
+	const float reachIn = W / rIn;
+
+	// --- clock ticks during this sample: sample the input at each tick's time, minus the kernel latency
+	double nextPosition = tickPosition + ticksPerSample;
+	int newTicks = (int)nextPosition;
+	for (int j = 1; j <= newTicks; j++)
+	{
+		// --- tick time relative to the newest input sample (0), in audio samples
+		float t = (float)(-1.0 + (j - tickPosition) / ticksPerSample) - reachIn;
+
+		int first = (int)ceilf(t - reachIn);
+		int last = (int)floorf(t + reachIn);
+		float sum = 0.0f;
+		for (int m = first; m <= last; m++)
+		{
+			sum += inputBuffer[(newest + m) & inputMask] * filterTap(rIn * (t - (float)m));
+		}
+
+		tickBuffer[(tickCount + j) & tickMask] = rIn * sum;
+	}
+	tickCount += newTicks;
+	tickPosition = nextPosition - newTicks;
+
+	// Output resampler: ticks leaving the register (bucketDelay ticks old), kernel stretched
+	// to the audio rate when the clock is faster
+	const float rOut = ticksPerSample > 1.0 ? (float)(1.0 / ticksPerSample) : 1.0f;
+	const float reachOut = W / rOut;
+
+	float kappa = (float)tickPosition - reachOut;
+	int first = (int)ceilf(kappa - reachOut);
+	int last = (int)floorf(kappa + reachOut);
+	float sum = 0.0f;
+	for (int k = first; k <= last; k++)
+	{
+		sum += tickBuffer[(tickCount + k - bucketDelay) & tickMask] * filterTap(rOut * (kappa - (float)k));
+	}
+	double output = rOut * sum;
+
+	// --- reconstruction filter and expander (1:2) after the BBD
+	output = outputFilter.processAudioSample((float)output, 0, sampleRate);
+	if (parameters.enableCompander)
+	{
+		expanderEnvelope = companderCoeff * expanderEnvelope + (1.0 - companderCoeff) * fabs(output);
+		output *= fmax(expanderEnvelope, sqrt(1.0e-3)); // --- floor mirrors the compressor's
+	}
+
+	return (float)output;
+}
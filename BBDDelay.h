@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: BBDDelay.h
+  Description: Bucket-brigade (BBD) delay emulation for the flanger: clocked stage count, clock-rate
+  dependent sampling through polyphase input/output filters, analog filters and NE570-style companding
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "fxobjects.h"
+
+// A BBD with N stages is a shift register of N/2 samples taken at the clock rate, so the delay is
+// N / (2 * fclock) and the clock is what the flanger's LFO actually sweeps. This engine runs the
+// real clock: every clock tick samples the (filtered) input at that tick's fractional audio time,
+// and every audio sample reconstructs the output from the ticks leaving the register.
+//
+// Both resamplers read one Kaiser-windowed sinc prototype stored as a polyphase table
+// (BBD_FILTER_PHASES phases per tap, linear interpolation between phases), so no sinc( ) is evaluated
+// while processing. The prototype is stretched to whichever rate is lower, audio or clock: at slow
+// clocks the input is band limited to the clock rate (the BBD's own aliasing/imaging limit), at fast
+// clocks the output is band limited to the audio rate.
+
+// --- BBD constants
+const unsigned int BBD_FILTER_HALF_TAPS = 8;			// prototype half length (taps each side at unity stretch)
+const unsigned int BBD_FILTER_PHASES = 64;				// table phases per tap
+const double BBD_FILTER_CUTOFF = 0.45;					// prototype cutoff, fraction of the lower rate
+const double BBD_FILTER_KAISER_BETA = 8.0;				// Kaiser window beta (~80 dB stopband)
+const double BBD_MAX_TICKS_PER_SAMPLE = 16.0;			// clock limit (cost bound); sets the shortest delay
+const double BBD_MIN_CLOCK_RATIO = 0.125;				// clock / sample rate floor; sets the longest delay
+const unsigned int BBD_MAX_STAGES = 8192;
+
+struct BBDParameters
+{
+	BBDParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	BBDParameters& operator=(const BBDParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		stages = params.stages;
+		delay_mSec = params.delay_mSec;
+		inputFilterFc = params.inputFilterFc;
+		outputFilterFc = params.outputFilterFc;
+		enableCompander = params.enableCompander;
+
+		return *this;
+	}
+
+	// --- individual parameters
+	unsigned int stages = 1024;			// BBD stage count (even); changes take effect on reset( )
+	double delay_mSec = 3.0;			// delay through the whole device, filters included
+	double inputFilterFc = 10000.0;		// analog anti-aliasing filter ahead of the BBD
+	double outputFilterFc = 10000.0;	// analog reconstruction filter after the BBD
+	bool enableCompander = true;		// 2:1 compress before, 1:2 expand after (NE570)
+};
+
+class BBDDelay : public IAudioSignalProcessor
+{
+public:
+	BBDDelay(void);
+	~BBDDelay(void) {};
+
+	/** size the buffers for the stage count; allocates only when they grow (e.g. the first call), NOT realtime safe then */
+	virtual bool reset(double _sampleRate, int channel);
+
+	BBDParameters getParameters() { return parameters; }
+
+	void setParameters(const BBDParameters& params);
+
+	/** sweep the delay (e.g. from the flanger LFO) without touching the other parameters */
+	void setDelay_mSec(double delay_mSec);
+
+	/** current clock rate in Hz */
+	double getClockRate() { return clockRate; }
+
+	/** shortest and longest delay the clock range allows for the current stage count */
+	double getMinDelay_mSec();
+	double getMaxDelay_mSec();
+
+	/** process one sample through the BBD (mono; use one object per channel) */
+	virtual float processAudioSample(float xn, int channel, double _sampleRate);
+
+	virtual bool canProcessAudioFrame() { return false; }
+
+protected:
+	void buildFilterTable();
+	void updateClock();
+
+	/** prototype impulse response at x taps from center (|x| <= BBD_FILTER_HALF_TAPS), from the polyphase table */
+	inline float filterTap(float x)
+	{
+		float position = fabsf(x) * BBD_FILTER_PHASES;
+		int index = (int)position;
+		float fraction = position - (float)index;
+		return filterTable[index] + fraction * (filterTable[index + 1] - filterTable[index]);
+	}
+
+	BBDParameters parameters;
+	double sampleRate = 44100.0;
+
+	// --- polyphase prototype, one side: BBD_FILTER_HALF_TAPS * BBD_FILTER_PHASES + 2 points
+	std::unique_ptr<float[]> filterTable;
+
+	// --- input history at the audio rate
+	std::unique_ptr<float[]> inputBuffer;
+	unsigned int inputMask = 0;
+	unsigned int inputCapacity = 0;		// allocated length
+	unsigned int inputIndex = 0;		// next write, counts audio samples
+
+	// --- clock ticks: the samples taken into the BBD, indexed by tick count
+	std::unique_ptr<float[]> tickBuffer;
+	unsigned int tickMask = 0;
+	unsigned int tickCapacity = 0;		// allocated length
+	unsigned int bucketDelay = 512;		// stages / 2 ticks from input to output
+	unsigned int tickCount = 0;			// ticks so far
+	double tickPosition = 0.0;			// clock position in ticks at the current audio sample
+
+	double clockRate = 0.0;				// Hz
+	double ticksPerSample = 1.0;
+
+	// --- analog filters and compander
+	AudioFilter inputFilter;
+	AudioFilter outputFilter;
+	double compressorEnvelope = 0.0;
+	double expanderEnvelope = 0.0;
+	double companderCoeff = 0.0;		// one pole envelope coefficient (10 mSec)
+private:
+
+};
@@ -23,6 +23,28 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+void Flanger::reserve(double maxSampleRate, int maxChannels, MemoryArena* arena)
+{
+    float maxDelayTime = 0.02f + 0.02f;
+    int maxBufferSamples = (int)(maxDelayTime * (float)maxSampleRate) + 1;
+
+    if (arena != nullptr)
+    {
+        // Delay lines come from the arena; delayBuffer refers to them instead of owning memory
+        arenaChannels.resize(maxChannels);
+        for (int channel = 0; channel < maxChannels; ++channel)
+            arenaChannels[channel] = arena->allocate<float>(maxBufferSamples);
+        arenaSamples = maxBufferSamples;
+        delayBuffer.setDataToReferTo(arenaChannels.data(), maxChannels, maxBufferSamples);
+        return;
+    }
+
+    // Allocates once; later setSize calls that fit keep this memory
+    arenaChannels.clear();
+    arenaSamples = 0;
+    delayBuffer.setSize(maxChannels, maxBufferSamples);
+}
+
 bool Flanger::reset(double sampleRate, int inputChannels)
 {
     float maxDelayTime = 0.02f + 0.02f;
@@ -32,17 +54,47 @@ bool Flanger::reset(double sampleRate, int inputChannels)
         delayBufferSamples = 1;
     }
 
-    delayBuffer.setSize(inputChannels, delayBufferSamples);
+    // No allocation when reserve( ) covered this rate and channel count
+    if (delayBufferSamples <= arenaSamples && inputChannels <= (int)arenaChannels.size())
+        delayBuffer.setDataToReferTo(arenaChannels.data(), inputChannels, delayBufferSamples);
+    else
+        delayBuffer.setSize(inputChannels, delayBufferSamples, false, false, true);
     delayBuffer.clear();
 
     delayWritePosition = 0;
     lfoPhase = 0.0f;
     inverseSampleRate = 1.0f / (float)sampleRate;
     twoPi = 2.0f * M_PI;
+    interpolationMix = interpolationTarget;
+    interpolationStep = 1.0f / (interpolationFadeTime * (float)sampleRate);
 
     return true;
 }
 
+void Flanger::writeDry(const float* const* input, int numChannels, int numSamples, float gain)
+{
+    numChannels = jmin(numChannels, delayBuffer.getNumChannels());
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* data = delayBuffer.getWritePointer(channel);
+        int position = delayWritePosition;
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            data[position] = input[channel][sample] * gain;
+            if (++position >= delayBufferSamples)
+                position = 0;
+        }
+    }
+    delayWritePosition = (delayWritePosition + numSamples) % delayBufferSamples;
+}
+
+double Flanger::getTailLengthSeconds(double decayThreshold)
+{
+    // Each trip around the loop scales by feedbackGain and takes at most the longest delay
+    double trips = log(decayThreshold) / log((double)feedbackGain);
+    return (trips + 1.0) * (baseDelayTime + modDelayTime);
+}
+
 float Flanger::lfo(float phase, int waveform)
 {
     float out = 0.0f;
@@ -90,30 +142,48 @@ float Flanger::processAudioSample(float xn, int* localWritePosition, float* phas
     const float in = xn;
     float out = 0.0f;
 
-    float localDelayTime = (0.0025f + 0.001f * lfo(*phase, 1)) * (float)sampleRate;
+    float localDelayTime = (baseDelayTime + modDelayTime * lfo(*phase, 1)) * (float)sampleRate;
 
     float readPosition = fmodf((float)*localWritePosition - localDelayTime + (float)delayBufferSamples, delayBufferSamples);
     int localReadPosition = floorf(readPosition);
 
-    // Cubic Interpolation
     float fraction = readPosition - (float)localReadPosition;
-    float fractionSqrt = fraction * fraction;
-    float fractionCube = fractionSqrt * fraction;
-    
-    float sample0 = delayData[(localReadPosition - 1 + delayBufferSamples) % delayBufferSamples];
     float sample1 = delayData[(localReadPosition + 0)];
     float sample2 = delayData[(localReadPosition + 1) % delayBufferSamples];
-    float sample3 = delayData[(localReadPosition + 2) % delayBufferSamples];
 
-    float a0 = -0.5f * sample0 + 1.5f * sample1 - 1.5f * sample2 + 0.5f * sample3;
-    float a1 = sample0 - 2.5f * sample1 + 2.0f * sample2 - 0.5f * sample3;
-    float a2 = -0.5f * sample0 + 0.5f * sample2;
-    float a3 = sample1;
-    out = a0 * fractionCube + a1 * fractionSqrt + a2 * fraction + a3;
+    // Linear Interpolation
+    float linear = sample1 + fraction * (sample2 - sample1);
+
+    // Cubic Interpolation, skipped once fully faded to linear
+    if (interpolationMix < 1.0f)
+    {
+        float fractionSqrt = fraction * fraction;
+        float fractionCube = fractionSqrt * fraction;
+
+        float sample0 = delayData[(localReadPosition - 1 + delayBufferSamples) % delayBufferSamples];
+        float sample3 = delayData[(localReadPosition + 2) % delayBufferSamples];
+
+        float a0 = -0.5f * sample0 + 1.5f * sample1 - 1.5f * sample2 + 0.5f * sample3;
+        float a1 = sample0 - 2.5f * sample1 + 2.0f * sample2 - 0.5f * sample3;
+        float a2 = -0.5f * sample0 + 0.5f * sample2;
+        float a3 = sample1;
+        float cubic = a0 * fractionCube + a1 * fractionSqrt + a2 * fraction + a3;
+        out = cubic + interpolationMix * (linear - cubic);
+    }
+    else
+    {
+        out = linear;
+    }
+
+    // Crossfade toward the requested interpolation
+    if (interpolationMix < interpolationTarget)
+        interpolationMix = fminf(interpolationMix + interpolationStep, interpolationTarget);
+    else if (interpolationMix > interpolationTarget)
+        interpolationMix = fmaxf(interpolationMix - interpolationStep, interpolationTarget);
 
     //channelData[sample] = in + out * (*treeState.getRawParameterValue(FLANGER_DEPTH_ID) /100.0f); //currentInverted;
     float output = in + out * 1.0f * 1.0f;
-    delayData[*localWritePosition] = in + out * 0.5f; //* 0.5f;//currentFeedback;
+    delayData[*localWritePosition] = addDenormalOffset(in + out * feedbackGain); //* 0.5f;//currentFeedback;
 
     if (++*localWritePosition >= delayBufferSamples)
         *localWritePosition -= delayBufferSamples;
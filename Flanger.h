@@ -21,7 +21,7 @@
 
 #pragma once
 
-//#include "fxobjects.h"
+#include "fxobjects.h" // MemoryArena
 #include <JuceHeader.h>
 
 class Flanger
@@ -33,11 +33,25 @@ public:
 	};
 	~Flanger(void) {};
 
+	// Sizes the delay buffer for the highest sample rate and channel count, from the arena if given;
+	// reset( ) within those only clears it
+	void reserve(double maxSampleRate, int maxChannels, MemoryArena* arena = nullptr);
+
 	bool reset(double sampleRate, int inputChannels);
 
 	float lfo(float phase, int waveform);
 
 	float processAudioSample(float xn, int* localWritePosition, float* phase, double sampleRate);
+
+	// Time for the feedback loop to decay below decayThreshold (linear) after the input stops
+	double getTailLengthSeconds(double decayThreshold);
+
+	// Cheaper linear delay interpolation instead of cubic; the change is a crossfade over interpolationFadeTime
+	void setLinearInterpolation(bool linear) { interpolationTarget = linear ? 1.0f : 0.0f; }
+
+	// While bypassed: write the input (times gain) into the delay lines and advance, with no LFO,
+	// interpolation or feedback, so the lines hold current audio when processing resumes
+	void writeDry(const float* const* input, int numChannels, int numSamples, float gain);
     
     enum waveformIndex {
         waveformSine = 0,
@@ -55,7 +69,22 @@ public:
     float lfoPhase;
     float inverseSampleRate;
     float twoPi;
+
+    // Cubic (0) to linear (1) interpolation crossfade, advanced per sample; like lfoPhase, processBlock
+    // restores it at the start of each channel so every channel follows the same ramp
+    float interpolationMix = 0.0f;
+    float interpolationTarget = 0.0f;
+    float interpolationStep = 0.0f;
+    const float interpolationFadeTime = 0.02f; // seconds
+
+    // Delay sweep and feedback
+    const float baseDelayTime = 0.0025f; // seconds
+    const float modDelayTime = 0.001f; // seconds, LFO depth
+    const float feedbackGain = 0.5f;
 protected:
+    // Arena storage the delay buffer refers to, one line per channel (empty when it owns its memory)
+    std::vector<float*> arenaChannels;
+    int arenaSamples = 0;
 private:
 };
 
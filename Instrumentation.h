@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: Instrumentation.h
+  Description: Optional per-stage block timers for processBlock: scoped steady_clock timers feeding
+  lock-free histograms (min/mean/p99/max ns per block) that the editor reads
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+// Build with PEDAL_INSTRUMENTATION=1 (Projucer: Preprocessor Definitions) to time each stage of processBlock.
+// Without it, PEDAL_SCOPED_TIMER expands to nothing and none of the classes below are compiled.
+//
+// The audio thread is the only writer: each record( ) is a handful of relaxed atomic stores, no locks
+// and no allocation. The editor reads on the message thread; a snapshot may straddle one block, which is
+// fine for a readout. Timing uses std::chrono::steady_clock (a TSC read on current x86 and ARM platforms)
+// so the numbers are nanoseconds without calibrating RDTSC against the clock.
+
+#ifndef PEDAL_INSTRUMENTATION
+#define PEDAL_INSTRUMENTATION 0
+#endif
+
+#if PEDAL_INSTRUMENTATION
+
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <stdint.h>
+
+// --- instrumentation constants
+const int STATS_BUCKETS_PER_OCTAVE = 4;			// histogram resolution (~19% per bucket)
+const int STATS_NUM_BUCKETS = 32 * STATS_BUCKETS_PER_OCTAVE;	// 1 ns to ~4 s
+
+// Stages timed in processBlock
+enum ProcessorStage
+{
+    kStageGain = 0,
+    kStageSplit,
+    kStageEffects,
+    kStageRecombine,
+    kStageLimiter,
+    kStageTotal,
+    kNumProcessorStages
+};
+
+inline const char* getProcessorStageName(int stage)
+{
+    static const char* names[kNumProcessorStages] = { "Gain", "Split", "Effects", "Recombine", "Limiter", "Total" };
+    return stage >= 0 && stage < kNumProcessorStages ? names[stage] : "";
+}
+
+// Summary for display
+struct ProcessorStatsSnapshot
+{
+    uint64_t blocks = 0;
+    double min_ns = 0.0;
+    double mean_ns = 0.0;
+    double p99_ns = 0.0;	// upper edge of the histogram bucket holding the 99th percentile
+    double max_ns = 0.0;
+};
+
+// Block time statistics for one stage
+class ProcessorStats
+{
+public:
+    ProcessorStats(void) { clear(); };
+    ~ProcessorStats(void) {};
+
+    // Audio thread: add one block's time
+    void record(uint64_t ns)
+    {
+        if (resetRequested.load(std::memory_order_acquire))
+        {
+            clear();
+            resetRequested.store(false, std::memory_order_release);
+        }
+
+        int bucket = ns > 1 ? (int)(STATS_BUCKETS_PER_OCTAVE * log2((double)ns)) : 0;
+        bucket = bucket < STATS_NUM_BUCKETS ? bucket : STATS_NUM_BUCKETS - 1;
+
+        // --- single writer, so load + store is enough (no read-modify-write atomics)
+        histogram[bucket].store(histogram[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum_ns.store(sum_ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (ns < min_ns.load(std::memory_order_relaxed))
+            min_ns.store(ns, std::memory_order_relaxed);
+        if (ns > max_ns.load(std::memory_order_relaxed))
+            max_ns.store(ns, std::memory_order_relaxed);
+        blocks.store(blocks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Any thread: summary of the blocks so far
+    ProcessorStatsSnapshot getSnapshot() const
+    {
+        ProcessorStatsSnapshot snapshot;
+        snapshot.blocks = blocks.load(std::memory_order_acquire);
+        if (snapshot.blocks == 0)
+            return snapshot;
+
+        snapshot.min_ns = (double)min_ns.load(std::memory_order_relaxed);
+        snapshot.max_ns = (double)max_ns.load(std::memory_order_relaxed);
+        snapshot.mean_ns = (double)sum_ns.load(std::memory_order_relaxed) / snapshot.blocks;
+
+        uint64_t total = 0;
+        for (int i = 0; i < STATS_NUM_BUCKETS; i++)
+            total += histogram[i].load(std::memory_order_relaxed);
+
+        uint64_t count = 0;
+        for (int i = 0; i < STATS_NUM_BUCKETS; i++)
+        {
+            count += histogram[i].load(std::memory_order_relaxed);
+            if (count * 100 >= total * 99)
+            {
+                snapshot.p99_ns = pow(2.0, (double)(i + 1) / STATS_BUCKETS_PER_OCTAVE);
+                break;
+            }
+        }
+        snapshot.p99_ns = snapshot.p99_ns < snapshot.max_ns ? snapshot.p99_ns : snapshot.max_ns;
+        return snapshot;
+    }
+
+    // Any thread: start over; the audio thread clears on its next record( )
+    void requestReset() { resetRequested.store(true, std::memory_order_release); }
+
+protected:
+    void clear()
+    {
+        for (int i = 0; i < STATS_NUM_BUCKETS; i++)
+            histogram[i].store(0, std::memory_order_relaxed);
+        sum_ns.store(0, std::memory_order_relaxed);
+        min_ns.store(UINT64_MAX, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+        blocks.store(0, std::memory_order_release);
+    }
+
+    std::atomic<uint64_t> histogram[STATS_NUM_BUCKETS];
+    std::atomic<uint64_t> sum_ns;
+    std::atomic<uint64_t> min_ns;
+    std::atomic<uint64_t> max_ns;
+    std::atomic<uint64_t> blocks;
+    std::atomic<bool> resetRequested { false };
+};
+
+// Times its own scope into a ProcessorStats, or up to stop( ) for a stage that is not its own scope
+class ScopedBlockTimer
+{
+public:
+    ScopedBlockTimer(ProcessorStats& _stats) : stats(_stats), start(std::chrono::steady_clock::now()) {};
+    ~ScopedBlockTimer(void) { stop(); };
+
+    void stop()
+    {
+        if (stopped)
+            return;
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        stats.record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        stopped = true;
+    }
+
+private:
+    ProcessorStats& stats;
+    std::chrono::steady_clock::time_point start;
+    bool stopped = false;
+};
+
+#define PEDAL_TIMER_CONCAT_(a, b) a##b
+#define PEDAL_TIMER_CONCAT(a, b) PEDAL_TIMER_CONCAT_(a, b)
+#define PEDAL_SCOPED_TIMER(stats) ScopedBlockTimer PEDAL_TIMER_CONCAT(scopedBlockTimer, __LINE__)(stats)
+#define PEDAL_TIMER_BEGIN(name, stats) ScopedBlockTimer name(stats)
+#define PEDAL_TIMER_END(name) name.stop()
+
+#else
+
+#define PEDAL_SCOPED_TIMER(stats)
+#define PEDAL_TIMER_BEGIN(name, stats)
+#define PEDAL_TIMER_END(name)
+
+#endif
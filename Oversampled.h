@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: Oversampled.h
+  Description: Oversampling wrapper for any IAudioSignalProcessor: polyphase FIR upsampling,
+  the inner processor at Ratio x the sample rate, and polyphase FIR decimation
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "fxobjects.h"
+#include <vector>
+
+// The ASPiK Interpolator/Decimator need FFTW and only ship filters for 44.1 and 48 kHz, and their
+// FFT convolution adds a block of latency. This wrapper uses one time domain Kaiser-windowed sinc,
+// designed once for the ratio, for both directions:
+//
+//	- length N = Ratio * (OVERSAMPLING_TAPS_PER_PHASE - 1) + 1, linear phase, so the up and down filters
+//	  together delay by N - 1 fast samples = OVERSAMPLING_TAPS_PER_PHASE - 1 samples at the base rate
+//	- the upsampler runs each polyphase branch on the base rate input (no multiplies by stuffed zeros)
+//	- the decimator only computes the fast samples it keeps
+//
+// Use one wrapper per effect that needs it, e.g. Oversampled<TriodeClassA, 4>, so oversampling is
+// applied selectively instead of to the whole chain.
+
+// --- oversampling constants
+const unsigned int OVERSAMPLING_TAPS_PER_PHASE = 32;		// taps per polyphase branch; sets the latency
+const double OVERSAMPLING_CUTOFF = 0.5;						// filter cutoff, fraction of the base rate (base Nyquist)
+const double OVERSAMPLING_KAISER_BETA = 8.0;				// Kaiser window beta (~80 dB stopband)
+const unsigned int OVERSAMPLING_MAX_CHANNELS = 2;
+const int OVERSAMPLING_DEFAULT_BLOCK_SIZE = 512;
+
+// Runs the inner processor over a block at the fast rate. The default goes sample by sample through
+// processAudioSample( ); specialize it for a processor with its own block engine.
+template <class Processor>
+struct OversampledBlock
+{
+	static void process(Processor& processor, float* buffer, int numSamples, int channel, double _sampleRate)
+	{
+		for (int n = 0; n < numSamples; n++)
+		{
+			buffer[n] = processor.processAudioSample(buffer[n], channel, _sampleRate);
+		}
+	}
+};
+
+template <class Processor, unsigned int Ratio>
+class Oversampled : public IAudioSignalProcessor
+{
+	static_assert(Ratio >= 2 && Ratio <= 16, "Oversampled supports ratios from 2 to 16");
+
+public:
+	Oversampled(void)
+	{
+		designFilter();
+	};
+	~Oversampled(void) {};
+
+	/** the wrapped processor, for its parameters */
+	Processor& getProcessor() { return processor; }
+
+	/** largest block processAudioBlock( ) handles in one pass (longer blocks are split); takes effect on reset( ) */
+	void setMaxBlockSize(int _maxBlockSize) { maxBlockSize = _maxBlockSize > 0 ? _maxBlockSize : 1; }
+
+	/** resets the inner processor at Ratio x the sample rate and allocates the buffers; NOT realtime safe */
+	virtual bool reset(double _sampleRate, int channel)
+	{
+		sampleRate = _sampleRate;
+		processor.reset(sampleRate * Ratio, channel);
+
+		if (channel < 0 || channel >= (int)OVERSAMPLING_MAX_CHANNELS)
+			return false;
+
+		// --- [history | block]: the history holds what the filters still need from the last block
+		upBuffer[channel].assign(OVERSAMPLING_TAPS_PER_PHASE - 1 + maxBlockSize, 0.0f);
+		fastBuffer[channel].assign(filterLength - 1 + maxBlockSize * Ratio, 0.0f);
+		allocatedBlockSize[channel] = maxBlockSize;
+
+		return true;
+	}
+
+	/** base rate samples of delay added by the filters (the inner processor's own latency is not included) */
+	static int getLatencyInSamples() { return OVERSAMPLING_TAPS_PER_PHASE - 1; }
+
+	/** process a block: upsample, run the inner processor at the fast rate, decimate; in place is fine */
+	void processAudioBlock(const float* input, float* output, int numSamples, int channel)
+	{
+		if (channel < 0 || channel >= (int)OVERSAMPLING_MAX_CHANNELS || allocatedBlockSize[channel] == 0)
+			return;
+
+		while (numSamples > 0)
+		{
+			int count = numSamples < allocatedBlockSize[channel] ? numSamples : allocatedBlockSize[channel];
+			processChunk(input, output, count, channel);
+
+			input += count;
+			output += count;
+			numSamples -= count;
+		}
+	}
+
+	/** one sample through the same path (a block of one) */
+	virtual float processAudioSample(float xn, int channel, double _sampleRate)
+	{
+		if (channel < 0 || channel >= (int)OVERSAMPLING_MAX_CHANNELS || allocatedBlockSize[channel] == 0)
+			return xn;
+
+		float yn = 0.0f;
+		processChunk(&xn, &yn, 1, channel);
+		return yn;
+	}
+
+	virtual bool canProcessAudioFrame() { return false; }
+
+protected:
+	static const unsigned int filterLength = Ratio * (OVERSAMPLING_TAPS_PER_PHASE - 1) + 1;
+
+	void designFilter()
+	{
+		// --- Kaiser window needs I0( ); series converges quickly for beta < 20
+		auto besselI0 = [](double x)
+		{
+			double sum = 1.0;
+			double term = 1.0;
+			for (int k = 1; k < 50 && term > sum * 1.0e-12; k++)
+			{
+				term *= (x / (2.0 * k)) * (x / (2.0 * k));
+				sum += term;
+			}
+			return sum;
+		};
+
+		double h[filterLength];
+		double center = 0.5 * (filterLength - 1);
+		double fc = OVERSAMPLING_CUTOFF / Ratio; // cycles per fast sample
+		double i0Beta = besselI0(OVERSAMPLING_KAISER_BETA);
+		double sum = 0.0;
+
+		for (unsigned int i = 0; i < filterLength; i++)
+		{
+			double x = i - center;
+			double sinc = x == 0.0 ? 2.0 * fc : sin(2.0 * kPi * fc * x) / (kPi * x);
+			double ratio = x / center;
+			h[i] = sinc * besselI0(OVERSAMPLING_KAISER_BETA * sqrt(fmax(0.0, 1.0 - ratio * ratio))) / i0Beta;
+			sum += h[i];
+		}
+
+		// --- unity gain at DC for the decimator; the upsampler adds the Ratio gain back
+		for (unsigned int p = 0; p < Ratio; p++)
+		{
+			for (unsigned int k = 0; k < OVERSAMPLING_TAPS_PER_PHASE; k++)
+			{
+				unsigned int i = p + k * Ratio;
+				upPhases[p][k] = i < filterLength ? (float)(Ratio * h[i] / sum) : 0.0f;
+			}
+		}
+		for (unsigned int i = 0; i < filterLength; i++)
+		{
+			downTaps[i] = (float)(h[i] / sum);
+		}
+	}
+
+	void processChunk(const float* input, float* output, int count, int channel)
+	{
+		const int upHistory = OVERSAMPLING_TAPS_PER_PHASE - 1;
+		const int fastHistory = filterLength - 1;
+		float* up = upBuffer[channel].data();
+		float* fast = fastBuffer[channel].data();
+
+		// --- upsample: fast[nR + p] = sum_k upPhases[p][k] * x[n - k]
+		memcpy(up + upHistory, input, count * sizeof(float));
+		float* fastBlock = fast + fastHistory;
+		for (int n = 0; n < count; n++)
+		{
+			const float* x = up + upHistory + n;
+			for (unsigned int p = 0; p < Ratio; p++)
+			{
+				float sum = 0.0f;
+				for (unsigned int k = 0; k < OVERSAMPLING_TAPS_PER_PHASE; k++)
+				{
+					sum += upPhases[p][k] * x[-(int)k];
+				}
+				fastBlock[n * Ratio + p] = sum;
+			}
+		}
+
+		// --- inner processor at the fast rate, in place
+		OversampledBlock<Processor>::process(processor, fastBlock, count * Ratio, channel, sampleRate * Ratio);
+
+		// --- decimate: keep fast sample nR, y[n] = sum_i downTaps[i] * fast[nR - i]
+		for (int n = 0; n < count; n++)
+		{
+			const float* v = fastBlock + n * Ratio;
+			float sum = 0.0f;
+			for (unsigned int i = 0; i < filterLength; i++)
+			{
+				sum += downTaps[i] * v[-(int)i];
+			}
+			output[n] = sum;
+		}
+
+		// --- carry the histories to the next chunk
+		memmove(up, up + count, upHistory * sizeof(float));
+		memmove(fast, fast + count * Ratio, fastHistory * sizeof(float));
+	}
+
+	Processor processor;
+	double sampleRate = 44100.0;
+	int maxBlockSize = OVERSAMPLING_DEFAULT_BLOCK_SIZE;
+
+	// --- filters: polyphase branches for the upsampler, full FIR for the decimator
+	float upPhases[Ratio][OVERSAMPLING_TAPS_PER_PHASE] = { { 0.0f } };
+	float downTaps[filterLength] = { 0.0f };
+
+	// --- per channel buffers, allocated in reset( )
+	std::vector<float> upBuffer[OVERSAMPLING_MAX_CHANNELS];		// base rate [history | block]
+	std::vector<float> fastBuffer[OVERSAMPLING_MAX_CHANNELS];		// fast rate [history | block]
+	int allocatedBlockSize[OVERSAMPLING_MAX_CHANNELS] = { 0, 0 };
+};
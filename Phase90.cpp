@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: Phase90.cpp
+  Description: Circuit-level model of the MXR Phase 90 phaser: four op-amp allpass stages whose
+  resistor is a JFET channel, simulated with WDF components and a precomputed JFET solver table
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#include "Phase90.h"
+
+//==============================================================================
+// Phase90SolverTable
+
+Phase90SolverTable::Phase90SolverTable(void)
+{
+	table.reset(new float[PHASE90_TABLE_VOV_POINTS * PHASE90_TABLE_WAVE_POINTS]);
+	vovScale = (PHASE90_TABLE_VOV_POINTS - 1) / (PHASE90_VOV_MAX - PHASE90_VOV_MIN);
+	waveScale = (PHASE90_TABLE_WAVE_POINTS - 1) / (2.0 * PHASE90_TABLE_MAX_WAVE);
+	build(1.0 / (2.0 * PHASE90_C * 44100.0));
+}
+
+void Phase90SolverTable::build(double Rp)
+{
+	for (unsigned int i = 0; i < PHASE90_TABLE_VOV_POINTS; i++)
+	{
+		double vov = PHASE90_VOV_MIN + i / vovScale;
+		for (unsigned int j = 0; j < PHASE90_TABLE_WAVE_POINTS; j++)
+		{
+			double a = -PHASE90_TABLE_MAX_WAVE + j / waveScale;
+			table[i * PHASE90_TABLE_WAVE_POINTS + j] = (float)solve(a, vov, Rp);
+		}
+	}
+}
+
+double Phase90SolverTable::solve(double a, double vov, double Rp)
+{
+	// f(v) = (a - v)/Rp - Id(v) falls monotonically from f(0) = a/Rp to f(a) = -Id(a),
+	// so the root lies between 0 and a; Newton-Raphson, falling back to bisection if a step leaves the bracket
+	double lo = a < 0.0 ? a : 0.0;
+	double hi = a < 0.0 ? 0.0 : a;
+	double v = 0.5 * (lo + hi);
+
+	for (int iteration = 0; iteration < 100; iteration++)
+	{
+		double dId = 0.0;
+		double f = (a - v) / Rp - phase90JfetCurrent(v, vov, dId);
+
+		if (f > 0.0)
+			lo = v;
+		else
+			hi = v;
+
+		double step = f / (1.0 / Rp + dId);
+		double next = v + step;
+		if (next <= lo || next >= hi)
+			next = 0.5 * (lo + hi);
+
+		if (fabs(next - v) < 1.0e-12)
+			return next;
+		v = next;
+	}
+	return v;
+}
+
+//==============================================================================
+// Phase90
+
+Phase90::Phase90(void)
+{
+	OscillatorParameters lfoParams = lfo.getParameters();
+	lfoParams.waveform = generatorWaveform::kTriangle; // kTriangle, kSin, kSaw
+	lfo.setParameters(lfoParams);
+
+	for (int c = 0; c < 2; c++)
+	{
+		for (unsigned int i = 0; i < PHASE90_STAGES; i++)
+		{
+			stages[c][i].setComponentValue(PHASE90_C);
+			stages[c][i].setSourceResistance(0.0); // --- op-amp driven, Rs = 0
+			stages[c][i].getDownstream().solverTable = &solverTable;
+		}
+	}
+}
+
+bool Phase90::reset(double _sampleRate, int channel)
+{
+	lfo.reset(_sampleRate, channel);
+	sampleRate = _sampleRate;
+
+	// --- the capacitor's port resistance sets the JFET port resistance, so the table follows the sample rate
+	double Rp = 1.0 / (2.0 * PHASE90_C * sampleRate);
+	if (Rp != tableRp)
+	{
+		solverTable.build(Rp);
+		tableRp = Rp;
+	}
+
+	if (channel < 0 || channel > 1)
+		return false;
+
+	for (unsigned int i = 0; i < PHASE90_STAGES; i++)
+	{
+		stages[channel][i].reset(sampleRate);
+		stages[channel][i].initializeAdaptorChain();
+	}
+	feedbackState[channel] = 0.0;
+
+	return true;
+}
+
+void Phase90::setParameters(const PhaserStruct& params)
+{
+	if (params.lfoRate != phaserStructure.lfoRate)
+	{
+		OscillatorParameters lfoParams = lfo.getParameters();
+		lfoParams.frequency_Hz = params.lfoRate;
+		lfo.setParameters(lfoParams);
+	}
+	phaserStructure = params;
+}
+
+float Phase90::processAudioSample(float xn, int channel, double _sampleRate)
+{
+	if (channel < 0 || channel > 1)
+		return xn;
+
+	SignalGenData lfoDat = lfo.renderAudioOutput();
+
+	// LFO sweeps the JFET gates; the overdrive (and so each stage's fc) follows it linearly
+	double lfoVal = phaserStructure.quadPhaseLFO ? lfoDat.quadPhaseOutput_pos : lfoDat.normalOutput;
+	double sweep = bipolarToUnipolar(lfoVal) * (phaserStructure.lfoDepth / 100.0);
+	double vov = PHASE90_VOV_MIN + sweep * (PHASE90_VOV_MAX - PHASE90_VOV_MIN);
+
+	// Input in volts, plus feedback from the last stage
+	double K = (phaserStructure.intensity / 100.0) * PHASE90_MAX_FEEDBACK;
+	double u = xn * inputLevel + K * feedbackState[channel];
+
+	// Four allpass stages: out = 2*v+ - in
+	for (unsigned int i = 0; i < PHASE90_STAGES; i++)
+	{
+		StageType& stage = stages[channel][i];
+		stage.getDownstream().vov = vov;
+		double vPlus = stage.processAudioSample(u);
+		u = 2.0 * vPlus - u;
+	}
+	feedbackState[channel] = u;
+
+	double wet = u / inputLevel;
+	return (1.0 - (phaserStructure.drywet / 100)) * xn + (phaserStructure.drywet / 100) * wet;
+}
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: Phase90.h
+  Description: Circuit-level model of the MXR Phase 90 phaser: four op-amp allpass stages whose
+  resistor is a JFET channel, simulated with WDF components and a precomputed JFET solver table
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "fxobjects.h"
+#include "PhaserN.h"
+
+// --- Phase 90 allpass stage:
+//
+//		in --+-- 10k --+-- (-) op-amp -- out		out = 2*v+ - in
+//			 |         +-- 10k --------+
+//			 +-- C --+-- (+)
+//					 JFET (drain-source, gate = LFO)
+//					 |
+//					gnd
+//
+// The C and JFET form a highpass divider at the non-inverting input; with the JFET as a resistor R
+// the stage is a first order allpass at fc = 1/(2*pi*R*C). The JFET is a square law device in its
+// triode region, so R depends on the signal across it as well as on the gate voltage (the LFO).
+
+// --- circuit constants
+const unsigned int PHASE90_STAGES = 4;
+const double PHASE90_C = 47.0e-9;				// stage capacitor (F)
+const double PHASE90_JFET_BETA = 0.75e-3;		// transconductance parameter (A/V^2), ~IDSS/Vp^2 for a 2N5952
+const double PHASE90_JFET_LAMBDA = 0.02;		// channel length modulation (1/V)
+const double PHASE90_VOV_MIN = 0.04;			// gate overdrive (Vgs - Vp) at the bottom of the sweep, ~200 Hz stage fc
+const double PHASE90_VOV_MAX = 0.6;				// gate overdrive at the top of the sweep, ~3 kHz stage fc
+const double PHASE90_MAX_FEEDBACK = 0.6;		// stage 4 -> stage 1 feedback at 100% intensity (block logo version)
+const double PHASE90_INPUT_LEVEL = 0.1;			// volts at the stages for a full scale (1.0) sample
+
+// --- solver table size; covers the whole sweep and incident waves of +/- PHASE90_TABLE_MAX_WAVE volts
+const unsigned int PHASE90_TABLE_VOV_POINTS = 33;
+const unsigned int PHASE90_TABLE_WAVE_POINTS = 257;
+const double PHASE90_TABLE_MAX_WAVE = 2.0;
+
+// JFET drain current for drain-source voltage vds and gate overdrive vov (symmetric n-channel square law
+// with channel length modulation); dId returns dId/dvds
+inline double phase90JfetCurrent(double vds, double vov, double& dId)
+{
+	double v = fabs(vds);
+	double sign = vds < 0.0 ? -1.0 : 1.0;
+	double clm = 1.0 + PHASE90_JFET_LAMBDA * v;
+
+	// --- saturation
+	if (v >= vov)
+	{
+		dId = PHASE90_JFET_BETA * vov * vov * PHASE90_JFET_LAMBDA;
+		return sign * PHASE90_JFET_BETA * vov * vov * clm;
+	}
+
+	// --- triode
+	double square = 2.0 * vov * v - v * v;
+	dId = PHASE90_JFET_BETA * ((2.0 * vov - 2.0 * v) * clm + PHASE90_JFET_LAMBDA * square);
+	return sign * PHASE90_JFET_BETA * square * clm;
+}
+
+// Node voltage at the JFET for every (gate overdrive, incident wave) pair, solved once per sample rate.
+// At run time a bilinear lookup is the initial guess for one Newton-Raphson step.
+class Phase90SolverTable
+{
+public:
+	Phase90SolverTable(void);
+	~Phase90SolverTable(void) {};
+
+	/** solve the table for the WDF port resistance Rp (depends on the sample rate); NOT realtime safe */
+	void build(double Rp);
+
+	/** interpolated node voltage for gate overdrive vov and incident wave a */
+	inline double lookup(double vov, double a)
+	{
+		double x = (vov - PHASE90_VOV_MIN) * vovScale;
+		double y = (a + PHASE90_TABLE_MAX_WAVE) * waveScale;
+		x = x < 0.0 ? 0.0 : (x > PHASE90_TABLE_VOV_POINTS - 1.001 ? PHASE90_TABLE_VOV_POINTS - 1.001 : x);
+		y = y < 0.0 ? 0.0 : (y > PHASE90_TABLE_WAVE_POINTS - 1.001 ? PHASE90_TABLE_WAVE_POINTS - 1.001 : y);
+
+		int i = (int)x;
+		int j = (int)y;
+		float fx = (float)(x - i);
+		float fy = (float)(y - j);
+
+		const float* row0 = &table[i * PHASE90_TABLE_WAVE_POINTS + j];
+		const float* row1 = row0 + PHASE90_TABLE_WAVE_POINTS;
+		float v0 = row0[0] + fy * (row0[1] - row0[0]);
+		float v1 = row1[0] + fy * (row1[1] - row1[0]);
+		return v0 + fx * (v1 - v0);
+	}
+
+	/** fully converged solve, used to build the table */
+	static double solve(double a, double vov, double Rp);
+
+protected:
+	std::unique_ptr<float[]> table;
+	double vovScale = 0.0;		// table points per volt of overdrive
+	double waveScale = 0.0;		// table points per volt of incident wave
+};
+
+// Nonlinear WDF root: plugs into WdfStaticSeriesAdaptor<WdfCapacitor, WdfJfetRoot> as its downstream port.
+// The series adaptor hands its wave down negated (out2 = -(in1 + N2)), so the node voltage is -(a + b)/2;
+// the JFET law is odd, so the solve itself does not depend on that sign.
+struct WdfJfetRoot
+{
+	Phase90SolverTable* solverTable = nullptr;
+	double vov = PHASE90_VOV_MIN;	// gate overdrive, set from the LFO each sample
+	double G = 0.0;					// port conductance 1/Rp
+	double a = 0.0;
+	double b = 0.0;
+
+	void reset(double _sampleRate) { a = 0.0; b = 0.0; }
+	void initialize(double _R1) { G = 1.0 / _R1; }
+
+	/** reflect the incident wave: (a - v)/Rp = Id(v), b = 2v - a */
+	inline double setInput1(double in1)
+	{
+		a = in1;
+		double v = solverTable->lookup(vov, a);
+
+		// --- one Newton-Raphson step from the table guess; f' <= -1/Rp so it never diverges
+		double dId = 0.0;
+		double Id = phase90JfetCurrent(v, vov, dId);
+		v += ((a - v) * G - Id) / (G + dId);
+
+		b = 2.0 * v - a;
+		return b;
+	}
+
+	/** voltage at the op-amp's non-inverting input */
+	inline double getTerminalOutput() { return -0.5 * (a + b); }
+};
+
+class Phase90 : public IAudioSignalProcessor
+{
+public:
+	Phase90(void);
+	~Phase90(void) {};
+
+	virtual bool reset(double _sampleRate, int channel);
+
+	PhaserStruct getParameters() { return phaserStructure; }
+
+	void setParameters(const PhaserStruct& params);
+
+	/** volts at the stages for a full scale sample; higher levels drive the JFETs harder */
+	void setInputLevel(double _inputLevel) { inputLevel = _inputLevel > 1.0e-3 ? _inputLevel : 1.0e-3; }
+
+	virtual float processAudioSample(float xn, int channel, double _sampleRate);
+
+	virtual bool canProcessAudioFrame() { return false; }
+
+protected:
+	// --- C from the input to the JFET, JFET to ground
+	typedef WdfStaticSeriesAdaptor<WdfCapacitor, WdfJfetRoot> StageType;
+
+	PhaserStruct phaserStructure;
+	StageType stages[2][PHASE90_STAGES];	// 2 channels
+	double feedbackState[2] = { 0.0, 0.0 };	// stage 4 output, one sample late
+
+	Phase90SolverTable solverTable;		// shared by all stages
+	LFO lfo;
+	double sampleRate = 44100.0;
+	double inputLevel = PHASE90_INPUT_LEVEL;
+	double tableRp = 0.0;				// port resistance the table was built for
+private:
+
+};
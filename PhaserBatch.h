@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: PhaserBatch.h
+  Description: Runs up to 8 independent phasers with the same stage count side by side,
+  one per lane, with all state stored structure-of-arrays across the lanes
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PhaserN.h"
+
+// Each lane is one mono phaser voice (e.g. 4 stereo tracks = 8 lanes) with its own parameters,
+// LFO and APF state. Every per-sample step (LFO, coefficient update, gamma chain, cascade, mix)
+// is a loop over lanes with no branches, so one pass of the inner loop maps onto one 8-wide
+// (AVX) or two 4-wide (SSE/NEON) vector operations. The LFO is the PhaserN triangle LFO
+// and coefficients use apf1AlphaFast( ), so each lane tracks a PhaserN<Stages> to ~1e-6.
+template <unsigned int Stages, unsigned int Lanes = 8>
+class PhaserBatch
+{
+	static_assert(Stages >= PHASER_MIN_STAGES && Stages <= PHASER_MAX_STAGES, "PhaserBatch supports 2 to 12 stages");
+
+public:
+	PhaserBatch(void)
+	{
+		for (unsigned int i = 0; i < Stages; i++)
+		{
+			setStageRange(i, (float)phaserStage_minF[i], (float)phaserStage_maxF[i]);
+		}
+
+		for (unsigned int l = 0; l < Lanes; l++)
+		{
+			setParameters(l, PhaserStruct());
+		}
+
+		reset(44100.0);
+	};
+	~PhaserBatch(void) {};
+
+	/** number of lanes (independent phasers) processed together */
+	static unsigned int getLaneCount() { return Lanes; }
+
+	/** set the sample rate and flush every lane */
+	bool reset(double _sampleRate)
+	{
+		inverseSampleRate = (float)(1.0 / _sampleRate);
+
+		for (unsigned int l = 0; l < Lanes; l++)
+		{
+			resetLane(l);
+		}
+		return true;
+	}
+
+	/** flush one lane's LFO and APF state, e.g. when a track is reassigned to it */
+	void resetLane(unsigned int lane)
+	{
+		if (lane >= Lanes)
+			return;
+
+		lfoPhase[lane] = 0.0f;
+		lfoInc[lane] = parameters[lane].lfoRate * inverseSampleRate;
+		for (unsigned int i = 0; i < Stages; i++)
+		{
+			z1[i][lane] = 0.0f;
+		}
+	}
+
+	PhaserStruct getParameters(unsigned int lane) { return lane < Lanes ? parameters[lane] : PhaserStruct(); }
+
+	void setParameters(unsigned int lane, const PhaserStruct& params)
+	{
+		if (lane >= Lanes)
+			return;
+
+		parameters[lane] = params;
+
+		// Per-lane values the inner loops use directly
+		lfoInc[lane] = params.lfoRate * inverseSampleRate;
+		quadPhase[lane] = params.quadPhaseLFO ? 1.0f : 0.0f;
+		depth[lane] = params.lfoDepth / 100.0f;
+		K[lane] = params.intensity / 100.0f;
+		wet[lane] = params.drywet / 100.0f;
+	}
+
+	/** sweep range of one stage, shared by all lanes */
+	void setStageRange(unsigned int stage, float minF, float maxF)
+	{
+		if (stage >= Stages)
+			return;
+
+		halfRange[stage] = 0.5f * (maxF - minF);
+		midpoint[stage] = minF + halfRange[stage];
+	}
+
+	/** advance all lanes by one sample; frame[l] is lane l's input, replaced by its output */
+	void processAudioFrame(float* frame)
+	{
+		// LFO: bipolar triangle (and quad phase), same as LFO::renderAudioOutput( )
+		float modValue[Lanes];
+		for (unsigned int l = 0; l < Lanes; l++)
+		{
+			lfoPhase[l] -= (float)(int)lfoPhase[l];
+
+			float phaseQP = lfoPhase[l] + 0.25f;
+			phaseQP -= (float)(int)phaseQP;
+
+			float tri = 2.0f * fabsf(unipolarToBipolar(lfoPhase[l])) - 1.0f;
+			float triQP = 2.0f * fabsf(unipolarToBipolar(phaseQP)) - 1.0f;
+			float lfoVal = tri + quadPhase[l] * (triQP - tri);
+
+			float mod = lfoVal * depth[l];
+			modValue[l] = mod < -1.0f ? -1.0f : (mod > 1.0f ? 1.0f : mod);
+			lfoPhase[l] += lfoInc[l];
+		}
+
+		// Modulated APF coefficients
+		for (unsigned int i = 0; i < Stages; i++)
+		{
+			for (unsigned int l = 0; l < Lanes; l++)
+			{
+				alpha[i][l] = apf1AlphaFast(modValue[l] * halfRange[i] + midpoint[i], inverseSampleRate);
+			}
+		}
+
+		// Gamma chain and combined feedback, last stage first
+		float gamma[Lanes];
+		float Sn[Lanes];
+		for (unsigned int l = 0; l < Lanes; l++)
+		{
+			gamma[l] = 1.0f;
+			Sn[l] = 0.0f;
+		}
+		for (int i = (int)Stages - 1; i >= 0; i--)
+		{
+			for (unsigned int l = 0; l < Lanes; l++)
+			{
+				Sn[l] += gamma[l] * z1[i][l];
+				gamma[l] *= alpha[i][l];
+			}
+		}
+
+		// Form input to first APF, then the cascade
+		float u[Lanes];
+		for (unsigned int l = 0; l < Lanes; l++)
+		{
+			u[l] = (frame[l] + K[l] * Sn[l]) / (1.0f + K[l] * gamma[l]);
+		}
+		for (unsigned int i = 0; i < Stages; i++)
+		{
+			for (unsigned int l = 0; l < Lanes; l++)
+			{
+				float yn = alpha[i][l] * u[l] + z1[i][l];
+				z1[i][l] = u[l] - alpha[i][l] * yn;
+				u[l] = yn;
+			}
+		}
+
+		// Dry/wet mix
+		for (unsigned int l = 0; l < Lanes; l++)
+		{
+			frame[l] = (1.0f - wet[l]) * frame[l] + wet[l] * u[l];
+		}
+	}
+
+	/** process a block for every lane in place; laneBuffers[l] may be nullptr for an unused lane */
+	void processAudioBlock(float* const* laneBuffers, int numSamples)
+	{
+		float frame[Lanes];
+		for (int n = 0; n < numSamples; n++)
+		{
+			for (unsigned int l = 0; l < Lanes; l++)
+			{
+				frame[l] = laneBuffers[l] ? laneBuffers[l][n] : 0.0f;
+			}
+
+			processAudioFrame(frame);
+
+			for (unsigned int l = 0; l < Lanes; l++)
+			{
+				if (laneBuffers[l])
+					laneBuffers[l][n] = frame[l];
+			}
+		}
+	}
+
+protected:
+	PhaserStruct parameters[Lanes];
+
+	// Per-lane parameters, ready for the inner loops
+	float lfoInc[Lanes];
+	float quadPhase[Lanes];		// 0.0 = normal output, 1.0 = quad phase output
+	float depth[Lanes];
+	float K[Lanes];				// intensity (feedback)
+	float wet[Lanes];
+
+	// Per-lane state
+	float lfoPhase[Lanes];
+	float alpha[Stages][Lanes];
+	float z1[Stages][Lanes];
+
+	// Per-stage sweep ranges, shared across lanes
+	float halfRange[Stages];
+	float midpoint[Stages];
+
+	float inverseSampleRate = 1.0f / 44100.0f;
+private:
+
+};
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: PhaserCore.h
+  Description: Compact first-order APF cascade for the phaser circuit, storing only the
+  per-stage alpha coefficients and z^-1 registers (structure-of-arrays)
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "fxobjects.h"
+
+/**
+@apf1Alpha
+\ingroup FX-Functions
+
+@brief calculates the first order APF coefficient, same formula as filterAlgorithm::kAPF1
+
+\param fc - APF critical frequency (Hz)
+\param sampleRate - current sample rate
+\return alpha; the APF is H(z) = (alpha + z^-1) / (1 + alpha*z^-1)
+*/
+inline float apf1Alpha(float fc, double sampleRate)
+{
+	float t = tan((kPi * fc) / sampleRate);
+	return (t - 1.0f) / (t + 1.0f);
+}
+
+/**
+@apf1AlphaFast
+\ingroup FX-Functions
+
+@brief branch-free approximation of apf1Alpha( ) for vectorized loops
+
+- NOTES:\n
+(tan(w) - 1)/(tan(w) + 1) = tan(w - pi/4), and for 0 <= w < pi/2 the argument stays in [-pi/4, +pi/4]
+where the [5/4] Pade approximant of tan( ) has a max abs error of 2.3e-7 (float rounding level).
+Frequencies at or above Nyquist are clamped to the edge of that range.\n
+
+\param fc - APF critical frequency (Hz)
+\param inverseSampleRate - 1.0 / sample rate
+\return alpha
+*/
+inline float apf1AlphaFast(float fc, float inverseSampleRate)
+{
+	const float kQuarterPi = 0.25f * kPi;
+	float y = kPi * fc * inverseSampleRate - kQuarterPi;
+	y = y < -kQuarterPi ? -kQuarterPi : (y > kQuarterPi ? kQuarterPi : y);
+
+	float y2 = y * y;
+	return y * (945.0f - 105.0f * y2 + y2 * y2) / (945.0f - 420.0f * y2 + 15.0f * y2 * y2);
+}
+
+// A first order APF in transpose canonical form only needs a0 = b1 = alpha and one state register:
+//     y(n) = alpha*x(n) + z1
+//     z1   = x(n) - alpha*y(n)
+// so the whole cascade is alpha[Stages] plus z1[Stages][Channels]; for 4 stages x 2 channels
+// that is 48 contiguous bytes (fits in one cache line) instead of four full AudioFilter objects.
+// z1 is stage-major so the channel loop in processAudioFrame( ) runs over contiguous registers
+// and vectorizes across channels.
+template <unsigned int Stages, unsigned int Channels = 2>
+struct alignas(16) PhaserCore
+{
+	float alpha[Stages];			// per-stage APF coefficient (G value)
+	float z1[Stages][Channels];		// per-stage, per-channel state (S value)
+
+	PhaserCore()
+	{
+		for (unsigned int i = 0; i < Stages; i++)
+			alpha[i] = 0.0f;
+		reset();
+	}
+
+	/** flush all state registers */
+	void reset()
+	{
+		memset(&z1[0][0], 0, sizeof(float) * Stages * Channels);
+	}
+
+	/** flush one channel's state registers */
+	void reset(unsigned int channel)
+	{
+		if (channel >= Channels)
+			return;
+
+		for (unsigned int i = 0; i < Stages; i++)
+			z1[i][channel] = 0.0f;
+	}
+
+	/** set all stage coefficients from their critical frequencies */
+	void setStageFrequencies(const float* fc, double sampleRate)
+	{
+		for (unsigned int i = 0; i < Stages; i++)
+			alpha[i] = apf1Alpha(fc[i], sampleRate);
+	}
+
+	/** run one channel through the feedback cascade (Harma delay-free loop, K = intensity) */
+	float processAudioSample(float xn, float K, unsigned int channel)
+	{
+		// Gamma chain and combined feedback, last stage first
+		float gamma = 1.0f;
+		float Sn = 0.0f;
+		for (int i = (int)Stages - 1; i >= 0; i--)
+		{
+			Sn += gamma * z1[i][channel];
+			gamma *= alpha[i];
+		}
+
+		// Form input to first APF
+		float alpha0 = 1.0f / (1.0f + K * gamma);
+		float u = alpha0 * (xn + K * Sn);
+
+		// Cascade of APFs
+		for (unsigned int i = 0; i < Stages; i++)
+		{
+			float yn = alpha[i] * u + z1[i][channel];
+			z1[i][channel] = u - alpha[i] * yn;
+			u = yn;
+		}
+		return u;
+	}
+
+	/** run all channels of one frame through the cascade in lockstep; frame is processed in place */
+	void processAudioFrame(float* frame, float K)
+	{
+		float gamma = 1.0f;
+		float Sn[Channels];
+		for (unsigned int c = 0; c < Channels; c++)
+			Sn[c] = 0.0f;
+
+		for (int i = (int)Stages - 1; i >= 0; i--)
+		{
+			for (unsigned int c = 0; c < Channels; c++)
+				Sn[c] += gamma * z1[i][c];
+			gamma *= alpha[i];
+		}
+
+		float alpha0 = 1.0f / (1.0f + K * gamma);
+		for (unsigned int c = 0; c < Channels; c++)
+			frame[c] = alpha0 * (frame[c] + K * Sn[c]);
+
+		for (unsigned int i = 0; i < Stages; i++)
+		{
+			for (unsigned int c = 0; c < Channels; c++)
+			{
+				float yn = alpha[i] * frame[c] + z1[i][c];
+				z1[i][c] = frame[c] - alpha[i] * yn;
+				frame[c] = yn;
+			}
+		}
+	}
+};
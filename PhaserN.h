@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: PhaserN.h
+  Description: Describes an N-stage phaser circuit, modelled after PhaseShifter object in "Designing Audio Effect Plugins..."
+  with the number of APF stages (2 - 12) set at compile time
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "fxobjects.h"
+#include "PhaserCore.h"
+
+struct PhaserStruct {
+	PhaserStruct(){}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	PhaserStruct& operator=(const PhaserStruct& pStruct)	// need this override for collections to work
+	{
+		if (this == &pStruct)
+			return *this;
+
+		lfoRate = pStruct.lfoRate;
+		lfoDepth = pStruct.lfoDepth;
+		intensity = pStruct.intensity;
+		quadPhaseLFO = pStruct.quadPhaseLFO;
+		drywet = pStruct.drywet;
+
+		return *this;
+	}
+	// --- individual parameters
+	// LFO parameters
+	float lfoRate = 1.0f;
+	float lfoDepth = 100.0f;
+	float intensity = 75.0f;
+	bool quadPhaseLFO = false;
+
+	float drywet = 100.0f;
+};
+
+// --- constants for PhaserN
+const unsigned int PHASER_MIN_STAGES = 2;
+const unsigned int PHASER_MAX_STAGES = 12;
+const unsigned int PHASER_MAX_UPDATE_INTERVAL = 64;	// longest coefficient update interval (samples)
+
+// Min and max phaser rotation frequencies per stage
+// Stages 0 - 5 are the apf0 - apf5 ranges in fxobjects.h, so 4 stages = Phaser and 6 stages = PhaseShifter.
+// Stages 6 - 11 repeat those ranges, doubling up stage pairs for deeper notches (as in the 8/10/12 stage pedals)
+const double phaserStage_minF[PHASER_MAX_STAGES] = {
+	apf0_minF, apf1_minF, apf2_minF, apf3_minF, apf4_minF, apf5_minF,
+	apf0_minF, apf1_minF, apf2_minF, apf3_minF, apf4_minF, apf5_minF };
+
+const double phaserStage_maxF[PHASER_MAX_STAGES] = {
+	apf0_maxF, apf1_maxF, apf2_maxF, apf3_maxF, apf4_maxF, apf5_maxF,
+	apf0_maxF, apf1_maxF, apf2_maxF, apf3_maxF, apf4_maxF, apf5_maxF };
+
+template <unsigned int Stages>
+class PhaserN : public IAudioSignalProcessor
+{
+	static_assert(Stages >= PHASER_MIN_STAGES && Stages <= PHASER_MAX_STAGES, "PhaserN supports 2 to 12 stages");
+
+public:
+	PhaserN(void)
+	{
+		OscillatorParameters lfoParams = lfo.getParameters();
+		lfoParams.waveform = generatorWaveform::kTriangle; // kTriangle, kSin, kSaw
+		lfo.setParameters(lfoParams);
+
+		for (unsigned int i = 0; i < Stages; i++)
+		{
+			stage_fc[i] = 100.0f; // set critical frequency
+			stage_minF[i] = (float)phaserStage_minF[i];
+			stage_maxF[i] = (float)phaserStage_maxF[i];
+		}
+		apfCore.setStageFrequencies(stage_fc, sampleRate);
+	};
+	virtual ~PhaserN(void) {};
+
+	/** number of APF stages, fixed at compile time */
+	static unsigned int getStageCount() { return Stages; }
+
+	virtual bool reset(double _sampleRate, int channel)
+	{
+		lfo.reset(_sampleRate, channel);
+
+		sampleRate = _sampleRate;
+		apfCore.setStageFrequencies(stage_fc, sampleRate);
+		apfCore.reset((unsigned int)channel);
+
+		return true;
+	}
+
+	PhaserStruct getParameters() { return phaserStructure; }
+
+	void setParameters(const PhaserStruct& params) //Parameters change
+	{
+		if (params.lfoRate != phaserStructure.lfoRate)
+		{
+			OscillatorParameters lfoParams = lfo.getParameters();
+			lfoParams.frequency_Hz = params.lfoRate;
+			lfo.setParameters(lfoParams);
+		}
+		phaserStructure = params;
+	}
+
+	/** recompute the APF coefficients every interval samples (1 = every sample) and ramp them linearly in
+	    between; longer intervals save the per-stage tan( ) at the cost of a slightly lagging sweep. The ramp
+	    carries on from the current coefficients, so changing the interval mid-stream is click free */
+	void setCoefficientUpdateInterval(unsigned int interval)
+	{
+		updateInterval = interval < 1 ? 1 : (interval > PHASER_MAX_UPDATE_INTERVAL ? PHASER_MAX_UPDATE_INTERVAL : interval);
+		if (updateCountdown > updateInterval)
+			updateCountdown = updateInterval;
+	}
+
+	/** conservative time for the cascade to ring down below decayThreshold (linear) after the input stops:
+	    the slowest APF pole (lowest stage frequency) sets the decay, stretched by 1/(1 - K) for the feedback */
+	double getTailLengthSeconds(double decayThreshold)
+	{
+		float lowestF = stage_minF[0];
+		for (unsigned int i = 1; i < Stages; i++)
+			lowestF = stage_minF[i] < lowestF ? stage_minF[i] : lowestF;
+
+		double radius = fabs(apf1Alpha(lowestF, sampleRate));
+		radius = radius < 0.999999 ? radius : 0.999999;
+		double K = phaserStructure.intensity / 100.0;
+		K = K < 0.99 ? K : 0.99;
+
+		double samples = log(decayThreshold) / log(radius) / (1.0 - K);
+		return samples / sampleRate;
+	}
+
+	/** override the sweep range of one stage (defaults come from phaserStage_minF/maxF) */
+	void setStageRange(unsigned int stage, float minF, float maxF)
+	{
+		if (stage >= Stages)
+			return;
+
+		stage_minF[stage] = minF;
+		stage_maxF[stage] = maxF;
+	}
+
+	virtual float processAudioSample(float xn, int channel, double _sampleRate)
+	{
+		SignalGenData lfoDat = lfo.renderAudioOutput();
+
+		// Create bipolar modulator value
+		float lfoVal = phaserStructure.quadPhaseLFO ? lfoDat.quadPhaseOutput_pos : lfoDat.normalOutput;
+
+		float depth = phaserStructure.lfoDepth / 100.0;
+		float modValue = lfoVal * depth;
+
+		if (updateInterval == 1)
+		{
+			// Calculate modulated values for each APF from the stage tables
+			for (unsigned int i = 0; i < Stages; i++)
+			{
+				stage_fc[i] = doBipolarModulation(modValue, stage_minF[i], stage_maxF[i]);
+			}
+			apfCore.setStageFrequencies(stage_fc, sampleRate);
+			updateCountdown = 1;
+		}
+		else if (--updateCountdown == 0)
+		{
+			// Coarse update: aim each alpha at this sample's target, reached after updateInterval samples
+			for (unsigned int i = 0; i < Stages; i++)
+			{
+				stage_fc[i] = doBipolarModulation(modValue, stage_minF[i], stage_maxF[i]);
+				alphaStep[i] = (apf1Alpha(stage_fc[i], sampleRate) - apfCore.alpha[i]) / updateInterval;
+			}
+			updateCountdown = updateInterval;
+		}
+		if (updateInterval > 1)
+		{
+			for (unsigned int i = 0; i < Stages; i++)
+				apfCore.alpha[i] += alphaStep[i];
+		}
+
+		// Gamma chain, combined feedback Sn and the APF cascade, see PhaserCore.h:
+		// Sn = gamma(N-1)*S0 + ... + gamma1*S(N-2) + S(N-1), gamma(k) = G(N-k)*gamma(k-1)
+		float K = phaserStructure.intensity / 100.0;
+		float u = apfCore.processAudioSample(xn, K, (unsigned int)channel);
+
+		return (1.0 - (phaserStructure.drywet / 100)) * xn + (phaserStructure.drywet / 100) * u;
+	}
+
+	virtual bool canProcessAudioFrame() { return false; }
+
+protected:
+	PhaserStruct phaserStructure;
+	PhaserCore<Stages, 2> apfCore; // APF alpha and state registers, 2 channels
+	LFO lfo;
+	double sampleRate = 44100.0;
+
+	// Per-stage sweep ranges and current critical frequencies
+	float stage_minF[Stages];
+	float stage_maxF[Stages];
+	float stage_fc[Stages];
+
+	// Coefficient update interval and the per-sample ramp between updates
+	unsigned int updateInterval = 1;
+	unsigned int updateCountdown = 1;
+	float alphaStep[Stages] = { 0.0f };
+private:
+
+};
+
+// --- common variants
+typedef PhaserN<6> PhaserN6;
+typedef PhaserN<8> PhaserN8;
+typedef PhaserN<12> PhaserN12;
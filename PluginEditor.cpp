@@ -69,6 +69,10 @@ PedalEmulatorAudioProcessorEditor::PedalEmulatorAudioProcessorEditor (PedalEmula
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
     setSize (800, 500);
+
+#if PEDAL_INSTRUMENTATION
+    startTimerHz(4);
+#endif
 }
 
 PedalEmulatorAudioProcessorEditor::~PedalEmulatorAudioProcessorEditor()
@@ -79,6 +83,24 @@ PedalEmulatorAudioProcessorEditor::~PedalEmulatorAudioProcessorEditor()
 void PedalEmulatorAudioProcessorEditor::paint (Graphics& g)
 {
     g.fillAll(Colours::black); // color
+
+#if PEDAL_INSTRUMENTATION
+    // Block time readout per processBlock stage (microseconds)
+    g.setColour(Colours::white);
+    g.setFont(Font(Font::getDefaultMonospacedFontName(), 12.0f, Font::plain));
+    g.drawText("stage        blocks     min    mean     p99     max (us)", 10, getHeight() - 110, 500, 15, Justification::left);
+    for (int stage = 0; stage < kNumProcessorStages; ++stage)
+    {
+        ProcessorStatsSnapshot stats = processor.stageStats[stage].getSnapshot();
+        String line = String(getProcessorStageName(stage)).paddedRight(' ', 10)
+            + String((int64)stats.blocks).paddedLeft(' ', 9)
+            + String(stats.min_ns / 1000.0, 1).paddedLeft(' ', 8)
+            + String(stats.mean_ns / 1000.0, 1).paddedLeft(' ', 8)
+            + String(stats.p99_ns / 1000.0, 1).paddedLeft(' ', 8)
+            + String(stats.max_ns / 1000.0, 1).paddedLeft(' ', 8);
+        g.drawText(line, 10, getHeight() - 95 + 15 * stage, 500, 15, Justification::left);
+    }
+#endif
     /*
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
@@ -99,6 +121,13 @@ void PedalEmulatorAudioProcessorEditor::resized()
     drywetDial.setBounds(600, 90, 100, 100);
 }
 
+#if PEDAL_INSTRUMENTATION
+void PedalEmulatorAudioProcessorEditor::timerCallback()
+{
+    repaint();
+}
+#endif
+
 void PedalEmulatorAudioProcessorEditor::sliderValueChanged(Slider* slider)
 {
     if (slider == &gainSlider || slider == &flangerDepthDial || slider == &phaserRateDial || slider == &drywetDial) // If slider pointer is the gain slider
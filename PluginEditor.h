@@ -27,6 +27,9 @@
 */
 class PedalEmulatorAudioProcessorEditor  : public AudioProcessorEditor,
     public Slider::Listener
+#if PEDAL_INSTRUMENTATION
+    , private Timer
+#endif
 {
 public:
     PedalEmulatorAudioProcessorEditor (PedalEmulatorAudioProcessor&);
@@ -37,6 +40,10 @@ public:
     void resized() override;
 
     void sliderValueChanged(Slider* slider) override;
+
+#if PEDAL_INSTRUMENTATION
+    void timerCallback() override; // Refreshes the block time readout
+#endif
     
     ScopedPointer <AudioProcessorValueTreeState::SliderAttachment> volumeSliderAttach;
     ScopedPointer <AudioProcessorValueTreeState::SliderAttachment> flangerDepthValue;
@@ -31,6 +31,14 @@
 #define FLANGER_DEPTH_NAME "flangerDepth"
 #define DRYWET_ID "drywet"
 #define DRYWET_NAME "DryWet"
+#define SPLIT_ID "split"
+#define SPLIT_NAME "Split"
+#define SPLIT_FREQ_ID "split_freq"
+#define SPLIT_FREQ_NAME "splitFrequency"
+#define BYPASS_ID "bypass"
+#define BYPASS_NAME "Bypass"
+#define BYPASS_FLUSH_ID "bypass_flush"
+#define BYPASS_FLUSH_NAME "bypassFlush"
 
 //==============================================================================
 PedalEmulatorAudioProcessor::PedalEmulatorAudioProcessor()
@@ -60,8 +68,31 @@ PedalEmulatorAudioProcessor::PedalEmulatorAudioProcessor()
     
     NormalisableRange<float> drywetRange(0.0f, 100.0f); // Range creation for intensity
     treeState.createAndAddParameter(DRYWET_ID, DRYWET_NAME, DRYWET_NAME, drywetRange, 100.0f, nullptr, nullptr); // Intensity parameter creation
+
+    NormalisableRange<float> splitRange(0.0f, 1.0f, 1.0f); // Off/on
+    treeState.createAndAddParameter(SPLIT_ID, SPLIT_NAME, SPLIT_NAME, splitRange, 0.0f, nullptr, nullptr); // Split mode parameter creation
+
+    NormalisableRange<float> splitFreqRange(40.0f, 1000.0f); // Range creation for the split frequency
+    treeState.createAndAddParameter(SPLIT_FREQ_ID, SPLIT_FREQ_NAME, SPLIT_FREQ_NAME, splitFreqRange, 200.0f, nullptr, nullptr); // Split frequency parameter creation
+
+    NormalisableRange<float> bypassRange(0.0f, 1.0f, 1.0f); // Off/on
+    treeState.createAndAddParameter(BYPASS_ID, BYPASS_NAME, BYPASS_NAME, bypassRange, 0.0f, nullptr, nullptr); // Bypass parameter creation
+
+    NormalisableRange<float> bypassFlushRange(0.0f, 1.0f, 1.0f); // Keep the delay lines warm / flush them
+    treeState.createAndAddParameter(BYPASS_FLUSH_ID, BYPASS_FLUSH_NAME, BYPASS_FLUSH_NAME, bypassFlushRange, 0.0f, nullptr, nullptr); // Bypass mode parameter creation
     
     treeState.state = ValueTree("savedParams"); // Used for saving parameters
+
+    // Size every buffer for the highest supported rate and block now, so prepareToPlay only clears memory
+    // (hosts call it again on transport and rate changes, and allocating there can drop out)
+    // All of it comes from one arena, so the chain's working set is contiguous and cache line aligned
+    flanger.reserve(kMaxSupportedSampleRate, kChannels, &arena);
+    bandSplitter.reserve(kMaxSupportedBlockSize, &arena);
+    outputLimiter.setMaxChannels(kChannels);
+    outputLimiter.reserve(kMaxSupportedSampleRate, &arena);
+    int maxLatency = (int)(TRUEPEAK_MAX_LOOKAHEAD_MSEC * 0.001 * kMaxSupportedSampleRate + 0.5) - 1 + TRUEPEAK_FILTER_DELAY;
+    softBypass.reserve(maxLatency, kMaxSupportedBlockSize, &arena);
+    limiterPrimeBuffer.setSize(kChannels, maxLatency);
 }
 
 PedalEmulatorAudioProcessor::~PedalEmulatorAudioProcessor()
@@ -103,7 +134,12 @@ bool PedalEmulatorAudioProcessor::isMidiEffect() const
 
 double PedalEmulatorAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return tailLengthSeconds; // Set in prepareToPlay
+}
+
+AudioProcessorParameter* PedalEmulatorAudioProcessor::getBypassParameter() const
+{
+    return treeState.getParameter(BYPASS_ID);
 }
 
 int PedalEmulatorAudioProcessor::getNumPrograms()
@@ -139,6 +175,33 @@ void PedalEmulatorAudioProcessor::prepareToPlay (double sampleRate, int samplesP
     phaser.reset(sampleRate, 1);
     flanger.reset(sampleRate, getTotalNumInputChannels());
     //flanger.reset(sampleRate, 1);
+
+    // Load governor starts at full quality
+    governor.reset(sampleRate);
+    phaser.setCoefficientUpdateInterval(1);
+    flanger.setLinearInterpolation(false);
+
+    // Split mode crossover, sized for the host's block
+    bandSplitter.setMaxBlockSize(samplesPerBlock);
+    bandSplitter.reset(sampleRate, 0);
+
+    // Output limiter, linked across all channels; its lookahead is the plugin's latency
+    outputLimiter.setMaxChannels(getTotalNumOutputChannels());
+    outputLimiter.reset(sampleRate, 0);
+    setLatencySamples(outputLimiter.getLatencyInSamples());
+
+    // Bypass: the dry path is delayed by the same latency, so the host's compensation holds either way
+    softBypass.reserve(outputLimiter.getLatencyInSamples(), samplesPerBlock);
+    softBypass.setBypassed(*treeState.getRawParameterValue(BYPASS_ID) > 0.5f);
+    softBypass.reset(sampleRate, outputLimiter.getLatencyInSamples());
+    effectsSuspended = softBypass.isBypassed();
+    limiterStale = false;
+
+    // Tail: the effects ring down in series, then the limiter's lookahead empties
+    tailLengthSeconds = flanger.getTailLengthSeconds(kSilenceThreshold) + phaser.getTailLengthSeconds(kSilenceThreshold)
+        + kTailMargin + outputLimiter.getLatencyInSamples() / sampleRate;
+    tailLengthSamples = (int)(tailLengthSeconds * sampleRate) + 1;
+    tailSamplesRemaining = 0;
     previousGain = Decibels::decibelsToGain(*treeState.getRawParameterValue(GAIN_ID)/20);
     /*
     float maxDelayTime = 0.02f + 0.02f;
@@ -192,12 +255,51 @@ bool PedalEmulatorAudioProcessor::isBusesLayoutSupported (const BusesLayout& lay
 void PedalEmulatorAudioProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
 {
     ScopedNoDenormals noDenormals;
+    PEDAL_SCOPED_TIMER(stageStats[kStageTotal]);
+    governor.beginBlock();
     const int totalNumInputChannels  = getTotalNumInputChannels();
     const int totalNumOutputChannels = getTotalNumOutputChannels();
     const int numSamples = buffer.getNumSamples();
     float currentGain = pow(10, *treeState.getRawParameterValue(GAIN_ID) / 20);
 
+    // Bypass: fade to the dry input, then stop calling the effects. Warm mode keeps writing the
+    // flanger's delay lines; flush mode clears everything when processing resumes
+    const bool flushOnResume = *treeState.getRawParameterValue(BYPASS_FLUSH_ID) > 0.5f;
+    softBypass.setBypassed(hostBypassed || *treeState.getRawParameterValue(BYPASS_ID) > 0.5f);
+    if (softBypass.isBypassed())
+    {
+        if (!flushOnResume)
+            flanger.writeDry(buffer.getArrayOfReadPointers(), totalNumInputChannels, numSamples, currentGain);
+        softBypass.processBypassed(buffer.getArrayOfWritePointers(), totalNumInputChannels, numSamples);
+        effectsSuspended = true;
+
+        for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+            buffer.clear(i, 0, numSamples);
+
+        governor.endBlock(numSamples);
+        return;
+    }
+
+    if (effectsSuspended)
+    {
+        // Resuming: stale filter state would click into the fade, so clear it (no allocation, the buffers
+        // were reserved); the flanger and phaser are cleared only in flush mode. The limiter is refilled from
+        // the dry history below rather than zeroed, which would silence the processed side for a latency
+        if (flushOnResume)
+        {
+            phaser.reset(getSampleRate(), 0);
+            phaser.reset(getSampleRate(), 1);
+            flanger.reset(getSampleRate(), totalNumInputChannels);
+        }
+        bandSplitter.reset(getSampleRate(), 0);
+        limiterStale = true;
+        tailSamplesRemaining = tailLengthSamples;
+        effectsSuspended = false;
+    }
+    softBypass.pushDry(buffer.getArrayOfReadPointers(), totalNumInputChannels, numSamples);
+
     // Gain processing done across buffer outside of loop
+    PEDAL_TIMER_BEGIN(gainTimer, stageStats[kStageGain]);
     if (currentGain == previousGain)
     {
         buffer.applyGain(currentGain);
@@ -206,6 +308,37 @@ void PedalEmulatorAudioProcessor::processBlock (AudioBuffer<float>& buffer, Midi
         buffer.applyGainRamp(0, numSamples, previousGain, currentGain);
         previousGain = currentGain;
     }
+    PEDAL_TIMER_END(gainTimer);
+
+    // Silence detection: a loud block restarts the tail countdown; once the tail has run out the
+    // effects have nothing left to ring, so the (near silent) input passes through the dry line, which
+    // keeps the reported latency
+    float blockPeak = 0.0f;
+    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        blockPeak = jmax(blockPeak, buffer.getMagnitude(channel, 0, numSamples));
+
+    if (blockPeak >= kSilenceThreshold)
+        tailSamplesRemaining = tailLengthSamples;
+    else if (tailSamplesRemaining > 0)
+        tailSamplesRemaining -= numSamples;
+    else
+    {
+        softBypass.readDry(buffer.getArrayOfWritePointers(), totalNumInputChannels, numSamples, currentGain);
+        softBypass.mixDry(buffer.getArrayOfWritePointers(), totalNumInputChannels, numSamples);
+        limiterStale = true;
+
+        for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+            buffer.clear(i, 0, numSamples);
+
+        governor.endBlock(numSamples);
+        return;
+    }
+
+    if (limiterStale)
+    {
+        primeOutputLimiter(totalNumInputChannels, currentGain);
+        limiterStale = false;
+    }
 
     // Make sure to reset the state if your inner loop is processing
     // the samples and the outer loop is handling the channels.
@@ -214,6 +347,21 @@ void PedalEmulatorAudioProcessor::processBlock (AudioBuffer<float>& buffer, Midi
     //int lastChannel = 0;
     //int currentChannel = 0;
 
+    // Split mode: the effects below only see the highs, the lows stay dry
+    BandSplitterParameters splitParams = bandSplitter.getParameters();
+    splitParams.enableSplit = *treeState.getRawParameterValue(SPLIT_ID) > 0.5f;
+    splitParams.splitFrequency_Hz = *treeState.getRawParameterValue(SPLIT_FREQ_ID);
+    bandSplitter.setParameters(splitParams);
+    PEDAL_TIMER_BEGIN(splitTimer, stageStats[kStageSplit]);
+    bandSplitter.split(buffer.getArrayOfWritePointers(), totalNumInputChannels, numSamples);
+    PEDAL_TIMER_END(splitTimer);
+
+    // Quality for this block from the governor's last decision; both effects switch without clicks
+    phaser.setCoefficientUpdateInterval(governor.isReduced() ? kCoarsePhaserUpdate : 1);
+    flanger.setLinearInterpolation(governor.isReduced());
+    const float interpolationMixStart = flanger.interpolationMix;
+
+    PEDAL_TIMER_BEGIN(effectsTimer, stageStats[kStageEffects]);
     int locWritePosition;
     float phaseVal;
     float phaseMain;
@@ -225,6 +373,7 @@ void PedalEmulatorAudioProcessor::processBlock (AudioBuffer<float>& buffer, Midi
         flanger.delayData = flanger.delayBuffer.getWritePointer(channel);
         locWritePosition = flanger.delayWritePosition;
         phaseVal = flanger.lfoPhase;
+        flanger.interpolationMix = interpolationMixStart;
         int* writePtr = &locWritePosition;
         float* phasePtr = &phaseVal;
         
@@ -288,9 +437,43 @@ void PedalEmulatorAudioProcessor::processBlock (AudioBuffer<float>& buffer, Midi
     }
     flanger.delayWritePosition = locWritePosition;
     flanger.lfoPhase = phaseMain;
+    PEDAL_TIMER_END(effectsTimer);
+
+    PEDAL_TIMER_BEGIN(recombineTimer, stageStats[kStageRecombine]);
+    bandSplitter.recombine(buffer.getArrayOfWritePointers(), totalNumInputChannels, numSamples);
+    PEDAL_TIMER_END(recombineTimer);
+
+    // Output protection: true-peak limiting after all processing
+    PEDAL_TIMER_BEGIN(limiterTimer, stageStats[kStageLimiter]);
+    outputLimiter.processAudioBlock(buffer.getArrayOfWritePointers(), totalNumInputChannels, numSamples);
+    PEDAL_TIMER_END(limiterTimer);
+
+    softBypass.mixDry(buffer.getArrayOfWritePointers(), totalNumInputChannels, numSamples);
  
     for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
+
+    governor.endBlock(numSamples);
+}
+
+void PedalEmulatorAudioProcessor::primeOutputLimiter(int numChannels, float gain)
+{
+    const int latency = outputLimiter.getLatencyInSamples();
+    numChannels = jmin(numChannels, limiterPrimeBuffer.getNumChannels());
+
+    // No allocation: the limiter was reserved and the prime buffer sized for the longest lookahead
+    outputLimiter.reset(getSampleRate(), 0);
+    if (latency <= limiterPrimeBuffer.getNumSamples()
+        && softBypass.copyDryHistory(limiterPrimeBuffer.getArrayOfWritePointers(), numChannels, latency, gain))
+        outputLimiter.processAudioBlock(limiterPrimeBuffer.getArrayOfWritePointers(), numChannels, latency);
+}
+
+void PedalEmulatorAudioProcessor::processBlockBypassed (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
+{
+    // Hosts that bypass without the bypass parameter get the same fade and latency
+    hostBypassed = true;
+    processBlock(buffer, midiMessages);
+    hostBypassed = false;
 }
 
 //==============================================================================
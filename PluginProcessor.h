@@ -22,6 +22,9 @@
 #include <JuceHeader.h>
 #include "Phaser.h"
 #include "Flanger.h"
+#include "Instrumentation.h"
+#include "QualityGovernor.h"
+#include "SoftBypass.h"
 #include <string>
 
 //==============================================================================
@@ -43,6 +46,8 @@ public:
    #endif
 
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
+    void processBlockBypassed (AudioBuffer<float>&, MidiBuffer&) override;
+    AudioProcessorParameter* getBypassParameter() const override; // Host bypass is the "bypass" parameter
 
     //==============================================================================
     AudioProcessorEditor* createEditor() override;
@@ -76,9 +81,29 @@ public:
     
     float previousGain;
 
+    MemoryArena arena; // Buffer storage for the processors below; declared first so it outlives them
     Phaser phaser;
     Flanger flanger;
+    BandSplitter bandSplitter; // Split mode: leaves the lows dry
+    TruePeakLimiter outputLimiter; // Output protection (flanger feedback can clip)
+    QualityGovernor governor; // Cheaper effect modes when processBlock nears its deadline
+    static const unsigned int kCoarsePhaserUpdate = 32; // Phaser coefficient update interval under load
+    SoftBypass softBypass; // Fades to the latency aligned dry input; the effects stop once it is bypassed
+    bool effectsSuspended = false; // Last block was fully bypassed
+    bool hostBypassed = false; // Inside processBlockBypassed
+
+    // Silence detection: once the input has been below kSilenceThreshold for the whole tail, processing stops
+    const float kSilenceThreshold = 1.0e-5f; // -100 dBFS
+    const double kTailMargin = 0.05; // seconds, crossover and limiter release
+    double tailLengthSeconds = 0.0;
+    int tailLengthSamples = 0;
+    int tailSamplesRemaining = 0;
+    bool limiterStale = false; // Limiter lookahead does not hold the recent input (bypassed or silence skipped)
+    AudioBuffer<float> limiterPrimeBuffer; // Dry history that refills the limiter's lookahead when the effects resume
     static const int kChannels = 2; // 2 channels
+#if PEDAL_INSTRUMENTATION
+    ProcessorStats stageStats[kNumProcessorStages]; // Block times per stage, read by the editor
+#endif
 
     //float s0, s1, s2, s3;
     //float* delayData;
@@ -95,6 +120,9 @@ public:
     */
 
 protected:
+    // Reset the output limiter and run the last latency's worth of dry input (times gain) through it, so
+    // its lookahead holds what the dry line just played instead of stale or zeroed audio
+    void primeOutputLimiter(int numChannels, float gain);
     
     void updateParameters(int channel)
     {
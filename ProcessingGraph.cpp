@@ -0,0 +1,423 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: ProcessingGraph.cpp
+  Description: Block-based processing graph (DAG) of IAudioSignalProcessor nodes, with a
+  work-stealing scheduler that runs independent branches on several cores
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#include "ProcessingGraph.h"
+#include <chrono>
+
+//==============================================================================
+// WorkQueue
+
+void WorkQueue::push(int task)
+{
+	lock.lock();
+	tasks[tail++] = task;
+	lock.unlock();
+}
+
+bool WorkQueue::pop(int& task)
+{
+	bool found = false;
+	lock.lock();
+	if (tail > head)
+	{
+		task = tasks[--tail];
+		found = true;
+	}
+	if (head == tail)
+		head = tail = 0;
+	lock.unlock();
+	return found;
+}
+
+bool WorkQueue::steal(int& task)
+{
+	bool found = false;
+	lock.lock();
+	if (tail > head)
+	{
+		task = tasks[head++];
+		found = true;
+	}
+	if (head == tail)
+		head = tail = 0;
+	lock.unlock();
+	return found;
+}
+
+//==============================================================================
+// GraphScheduler
+
+GraphScheduler::~GraphScheduler()
+{
+	release();
+}
+
+void GraphScheduler::prepare(int _numWorkers, int maxTasks)
+{
+	release();
+
+	numWorkers = _numWorkers < 1 ? 1 : _numWorkers;
+
+	// Every task is queued exactly once per run, so maxTasks slots per queue can never overflow
+	queues.reset(new WorkQueue[numWorkers]);
+	for (int i = 0; i < numWorkers; i++)
+	{
+		queues[i].tasks.assign(maxTasks > 0 ? maxTasks : 1, 0);
+	}
+
+	running = true;
+	for (int i = 1; i < numWorkers; i++)
+	{
+		threads.push_back(std::thread(&GraphScheduler::workerLoop, this, i));
+	}
+}
+
+void GraphScheduler::release()
+{
+	{
+		std::lock_guard<std::mutex> guard(wakeMutex);
+		running = false;
+	}
+	wakeCondition.notify_all();
+
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		threads[i].join();
+	}
+	threads.clear();
+}
+
+void GraphScheduler::run(ISchedulerTaskRunner& runner, const int* initialTasks, int numInitialTasks, int totalTasks)
+{
+	if (totalTasks <= 0)
+		return;
+
+	// Set the count before any task is visible so it can't reach zero early
+	currentRunner.store(&runner, std::memory_order_release);
+	remainingTasks.store(totalTasks, std::memory_order_release);
+
+	// Deal the independent tasks round-robin so every worker starts with a branch
+	for (int i = 0; i < numInitialTasks; i++)
+	{
+		queues[i % numWorkers].push(initialTasks[i]);
+	}
+
+	// Wake the workers. Spinning workers see the new generation by themselves; sleepers get a notify
+	// without the mutex, so a worker that is just going to sleep can miss it and catch up on its
+	// GRAPH_SLEEP_TIMEOUT_MSEC recheck (this block runs without it)
+	generation.fetch_add(1);
+	if (numWorkers > 1 && sleepingWorkers.load() > 0)
+		wakeCondition.notify_all();
+
+	// The audio thread is worker 0 and stays until the last task is done
+	drain(0);
+}
+
+void GraphScheduler::workerLoop(int worker)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	unsigned int seenGeneration = generation.load(std::memory_order_acquire);
+	Clock::time_point lastBlock = Clock::now();
+	double blockInterval = GRAPH_MAX_SPIN_SEC;	// seconds between the last two blocks
+
+	while (running.load(std::memory_order_acquire))
+	{
+		// Spin through the gap to the next block while blocks keep coming
+		double spinLimit = GRAPH_IDLE_BLOCKS * blockInterval;
+		spinLimit = spinLimit < GRAPH_MIN_SPIN_SEC ? GRAPH_MIN_SPIN_SEC : (spinLimit > GRAPH_MAX_SPIN_SEC ? GRAPH_MAX_SPIN_SEC : spinLimit);
+
+		bool woke = false;
+		while (!woke)
+		{
+			woke = generation.load(std::memory_order_acquire) != seenGeneration;
+			if (woke)
+				break;
+
+			// --- dependents released later in the current block
+			if (remainingTasks.load(std::memory_order_acquire) > 0)
+				drain(worker);
+
+			if (std::chrono::duration<double>(Clock::now() - lastBlock).count() > spinLimit)
+				break;
+			std::this_thread::yield();
+		}
+
+		// No block for a while: sleep until one arrives; once asleep the worker costs nothing but the
+		// periodic recheck
+		if (!woke)
+		{
+			std::unique_lock<std::mutex> guard(wakeMutex);
+			sleepingWorkers.fetch_add(1);
+			while (generation.load() == seenGeneration && running.load())
+				wakeCondition.wait_for(guard, std::chrono::milliseconds(GRAPH_SLEEP_TIMEOUT_MSEC));
+			sleepingWorkers.fetch_sub(1);
+		}
+
+		if (!running.load(std::memory_order_acquire))
+			break;
+
+		Clock::time_point now = Clock::now();
+		double interval = std::chrono::duration<double>(now - lastBlock).count();
+		blockInterval = interval < GRAPH_MAX_SPIN_SEC ? interval : GRAPH_MAX_SPIN_SEC;
+		lastBlock = now;
+
+		seenGeneration = generation.load(std::memory_order_acquire);
+		drain(worker);
+	}
+}
+
+void GraphScheduler::drain(int worker)
+{
+	int idlePolls = 0;
+	while (remainingTasks.load(std::memory_order_acquire) > 0)
+	{
+		// Any task not yet started is fair game, whichever queue it is on: the audio thread takes
+		// work back from a worker that has not woken up (or was preempted) instead of waiting for it
+		int task = -1;
+		if (findTask(worker, task))
+		{
+			currentRunner.load(std::memory_order_acquire)->runTask(task, worker);
+
+			// Dependents were pushed inside runTask( ), before this count drops
+			remainingTasks.fetch_sub(1, std::memory_order_acq_rel);
+			idlePolls = 0;
+		}
+		else if (worker != 0)
+		{
+			// Nothing queued: a worker leaves the rest to whoever is running it; it is back
+			// through the spin in workerLoop( ) if more tasks show up this block
+			return;
+		}
+		else if (++idlePolls > GRAPH_DRAIN_SPINS)
+		{
+			// The audio thread only gets here while another thread runs a task it depends on and
+			// nothing else is queued; past a short spin it yields between polls of the queues
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool GraphScheduler::findTask(int worker, int& task)
+{
+	// Own queue first, then steal from the others starting with the next worker
+	if (queues[worker].pop(task))
+		return true;
+
+	for (int i = 1; i < numWorkers; i++)
+	{
+		if (queues[(worker + i) % numWorkers].steal(task))
+			return true;
+	}
+	return false;
+}
+
+//==============================================================================
+// ProcessingGraph
+
+int ProcessingGraph::addInputNode(int inputChannel)
+{
+	GraphNode node;
+	node.inputChannel = inputChannel;
+	nodes.push_back(node);
+	prepared = false;
+	return (int)nodes.size() - 1;
+}
+
+int ProcessingGraph::addProcessorNode(IAudioSignalProcessor* processor, int channel)
+{
+	GraphNode node;
+	node.processor = processor;
+	node.channel = channel;
+	nodes.push_back(node);
+	prepared = false;
+	return (int)nodes.size() - 1;
+}
+
+bool ProcessingGraph::connect(int fromNode, int toNode, float gain)
+{
+	if (fromNode < 0 || fromNode >= (int)nodes.size() || toNode < 0 || toNode >= (int)nodes.size() || fromNode == toNode)
+		return false;
+
+	// Input nodes only read the host buffer
+	if (nodes[toNode].inputChannel >= 0)
+		return false;
+
+	GraphEdge edge;
+	edge.node = fromNode;
+	edge.gain = gain;
+	nodes[toNode].inputs.push_back(edge);
+	nodes[fromNode].dependents.push_back(toNode);
+	prepared = false;
+	return true;
+}
+
+bool ProcessingGraph::connectToOutput(int node, int outputChannel, float gain)
+{
+	if (node < 0 || node >= (int)nodes.size() || outputChannel < 0)
+		return false;
+
+	GraphOutput output;
+	output.node = node;
+	output.channel = outputChannel;
+	output.gain = gain;
+	outputs.push_back(output);
+	return true;
+}
+
+void ProcessingGraph::clear()
+{
+	scheduler.release();
+	nodes.clear();
+	outputs.clear();
+	rootNodes.clear();
+	pendingInputs.reset();
+	prepared = false;
+}
+
+bool ProcessingGraph::prepare(double _sampleRate, int maxBlockSize, int numThreads)
+{
+	scheduler.release();
+	prepared = false;
+
+	sampleRate = _sampleRate;
+	maxSamples = maxBlockSize;
+
+	const int numNodes = (int)nodes.size();
+
+	// Kahn's algorithm: if not every node can be ordered, there is a cycle
+	std::vector<int> inDegree(numNodes, 0);
+	rootNodes.clear();
+	for (int i = 0; i < numNodes; i++)
+	{
+		inDegree[i] = (int)nodes[i].inputs.size();
+		if (inDegree[i] == 0)
+			rootNodes.push_back(i);
+	}
+
+	std::vector<int> order(rootNodes);
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const std::vector<int>& dependents = nodes[order[i]].dependents;
+		for (size_t d = 0; d < dependents.size(); d++)
+		{
+			if (--inDegree[dependents[d]] == 0)
+				order.push_back(dependents[d]);
+		}
+	}
+	if ((int)order.size() != numNodes)
+		return false;
+
+	// Block buffers and dependency counters
+	pendingInputs.reset(new std::atomic<int>[numNodes > 0 ? numNodes : 1]);
+	for (int i = 0; i < numNodes; i++)
+	{
+		nodes[i].buffer.assign(maxSamples > 0 ? maxSamples : 1, 0.0f);
+		if (nodes[i].processor)
+			nodes[i].processor->reset(sampleRate, nodes[i].channel);
+	}
+
+	scheduler.prepare(numThreads, numNodes);
+	prepared = true;
+	return true;
+}
+
+void ProcessingGraph::process(float* const* channelData, int numChannels, int numSamples)
+{
+	if (!prepared || numSamples > maxSamples)
+		return;
+
+	blockData = channelData;
+	blockChannels = numChannels;
+	blockSamples = numSamples;
+
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		pendingInputs[i].store((int)nodes[i].inputs.size(), std::memory_order_relaxed);
+	}
+
+	scheduler.run(*this, rootNodes.data(), (int)rootNodes.size(), (int)nodes.size());
+
+	// All nodes are done; write the outputs (inputs have already been read, so in place is safe)
+	for (int channel = 0; channel < numChannels; channel++)
+	{
+		memset(channelData[channel], 0, sizeof(float) * numSamples);
+	}
+	for (size_t i = 0; i < outputs.size(); i++)
+	{
+		if (outputs[i].channel >= numChannels)
+			continue;
+
+		float* out = channelData[outputs[i].channel];
+		const float* in = nodes[outputs[i].node].buffer.data();
+		const float gain = outputs[i].gain;
+		for (int n = 0; n < numSamples; n++)
+		{
+			out[n] += gain * in[n];
+		}
+	}
+}
+
+void ProcessingGraph::runTask(int task, int worker)
+{
+	GraphNode& node = nodes[task];
+	float* buffer = node.buffer.data();
+
+	if (node.inputChannel >= 0)
+	{
+		// Input node: copy the host channel
+		if (node.inputChannel < blockChannels)
+			memcpy(buffer, blockData[node.inputChannel], sizeof(float) * blockSamples);
+		else
+			memset(buffer, 0, sizeof(float) * blockSamples);
+	}
+	else
+	{
+		// Mix the inputs, then process
+		memset(buffer, 0, sizeof(float) * blockSamples);
+		for (size_t i = 0; i < node.inputs.size(); i++)
+		{
+			const float* in = nodes[node.inputs[i].node].buffer.data();
+			const float gain = node.inputs[i].gain;
+			for (int n = 0; n < blockSamples; n++)
+			{
+				buffer[n] += gain * in[n];
+			}
+		}
+
+		if (node.processor)
+		{
+			for (int n = 0; n < blockSamples; n++)
+			{
+				buffer[n] = node.processor->processAudioSample(buffer[n], node.channel, sampleRate);
+			}
+		}
+	}
+
+	// Release dependents; the last input to finish queues the node on this worker
+	for (size_t i = 0; i < node.dependents.size(); i++)
+	{
+		const int dependent = node.dependents[i];
+		if (pendingInputs[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			scheduler.push(worker, dependent);
+	}
+}
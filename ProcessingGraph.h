@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: ProcessingGraph.h
+  Description: Block-based processing graph (DAG) of IAudioSignalProcessor nodes, with a
+  work-stealing scheduler that runs independent branches on several cores
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "fxobjects.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The audio thread never blocks on the workers: it deals the tasks, wakes the workers without a lock
+// and runs tasks itself until the block is done. A worker that is asleep, slow to wake or preempted
+// only costs parallelism; in the worst case the audio thread processes the whole graph by itself.
+//
+// While blocks keep arriving, workers spin (yielding) through the gap between them, so run( ) does not
+// have to wake anyone; after GRAPH_IDLE_BLOCKS block periods without one they go to sleep.
+
+// --- scheduler constants
+const double GRAPH_IDLE_BLOCKS = 2.0;				// block periods a worker spins for before sleeping
+const double GRAPH_MIN_SPIN_SEC = 0.001;			// spin at least this long after a block
+const double GRAPH_MAX_SPIN_SEC = 0.05;				// and at most this long
+const int GRAPH_SLEEP_TIMEOUT_MSEC = 100;			// sleeping workers recheck this often (covers a missed wake-up)
+const int GRAPH_DRAIN_SPINS = 64;					// audio thread polls before it starts yielding while it waits
+
+// Short critical sections only (push/pop of one task index); never held across processing
+class SpinLock
+{
+public:
+	void lock() { while (flag.test_and_set(std::memory_order_acquire)) {} }
+	void unlock() { flag.clear(std::memory_order_release); }
+private:
+	std::atomic_flag flag = ATOMIC_FLAG_INIT;
+};
+
+// Implemented by whatever the scheduler runs; a task may push follow-up tasks on its worker
+class ISchedulerTaskRunner
+{
+public:
+	virtual ~ISchedulerTaskRunner() {}
+	virtual void runTask(int task, int worker) = 0;
+};
+
+// Per-worker task deque: the owner pushes/pops at the tail (LIFO, keeps a chain on one core),
+// idle workers steal from the head (FIFO, takes the oldest independent branch)
+struct WorkQueue
+{
+	std::vector<int> tasks;
+	int head = 0;
+	int tail = 0;
+	SpinLock lock;
+
+	void push(int task);
+	bool pop(int& task);
+	bool steal(int& task);
+};
+
+class GraphScheduler
+{
+public:
+	GraphScheduler(void) {};
+	~GraphScheduler(void);
+
+	/** create the worker threads and size the queues; NOT realtime safe, call from prepareToPlay
+	    numWorkers includes the calling (audio) thread, so 1 = serial processing with no threads */
+	void prepare(int numWorkers, int maxTasks);
+
+	/** stop and join the worker threads */
+	void release();
+
+	int getNumWorkers() const { return numWorkers; }
+
+	/** run one batch of tasks to completion on the calling thread plus the workers;
+	    initialTasks are the tasks with no dependencies, totalTasks is the count that will run */
+	void run(ISchedulerTaskRunner& runner, const int* initialTasks, int numInitialTasks, int totalTasks);
+
+	/** queue a ready task on a worker's deque (called from inside runTask) */
+	void push(int worker, int task) { queues[worker].push(task); }
+
+protected:
+	void workerLoop(int worker);
+	bool findTask(int worker, int& task);
+	void drain(int worker);
+
+	std::unique_ptr<WorkQueue[]> queues;
+	std::vector<std::thread> threads;
+	int numWorkers = 1;
+
+	std::atomic<ISchedulerTaskRunner*> currentRunner { nullptr };
+	std::atomic<int> remainingTasks { 0 };
+	std::atomic<unsigned int> generation { 0 };
+	std::atomic<bool> running { false };
+
+	// Idle workers sleep here until generation changes; run( ) notifies without the mutex, and only
+	// when a worker is asleep, so the audio thread never waits on it
+	std::mutex wakeMutex;
+	std::condition_variable wakeCondition;
+	std::atomic<int> sleepingWorkers { 0 };
+};
+
+class ProcessingGraph : public ISchedulerTaskRunner
+{
+public:
+	ProcessingGraph(void) {};
+	~ProcessingGraph(void) {};
+
+	/** node that reads one channel of the host buffer */
+	int addInputNode(int inputChannel);
+
+	/** node that sums its inputs and runs them through processor->processAudioSample( ) on the given channel;
+	    a processor instance must only appear in nodes that are ordered by edges (it is not thread safe) */
+	int addProcessorNode(IAudioSignalProcessor* processor, int channel);
+
+	/** route fromNode into toNode, scaled by gain; nodes with several inputs mix them */
+	bool connect(int fromNode, int toNode, float gain = 1.0f);
+
+	/** mix a node into an output channel of the host buffer */
+	bool connectToOutput(int node, int outputChannel, float gain = 1.0f);
+
+	/** remove all nodes and connections */
+	void clear();
+
+	/** sort and validate the graph, allocate block buffers and start the workers; NOT realtime safe
+	    returns false if the graph has a cycle */
+	bool prepare(double _sampleRate, int maxBlockSize, int numThreads);
+
+	/** process one block in place; channels not connected to the output are cleared */
+	void process(float* const* channelData, int numChannels, int numSamples);
+
+	/** ISchedulerTaskRunner: process one node, then release its dependents */
+	virtual void runTask(int task, int worker);
+
+	int getNumNodes() const { return (int)nodes.size(); }
+
+protected:
+	struct GraphEdge
+	{
+		int node = 0;
+		float gain = 1.0f;
+	};
+
+	struct GraphOutput
+	{
+		int node = 0;
+		int channel = 0;
+		float gain = 1.0f;
+	};
+
+	struct GraphNode
+	{
+		IAudioSignalProcessor* processor = nullptr;
+		int channel = 0;
+		int inputChannel = -1;				// >= 0 for input nodes
+		std::vector<GraphEdge> inputs;
+		std::vector<int> dependents;
+		std::vector<float> buffer;			// one block, preallocated in prepare( )
+	};
+
+	std::vector<GraphNode> nodes;
+	std::vector<GraphOutput> outputs;
+	std::vector<int> rootNodes;				// nodes with no inputs
+	std::unique_ptr<std::atomic<int>[]> pendingInputs;
+
+	GraphScheduler scheduler;
+	double sampleRate = 44100.0;
+	int maxSamples = 0;
+	bool prepared = false;
+
+	// Host buffer for the block being processed
+	float* const* blockData = nullptr;
+	int blockChannels = 0;
+	int blockSamples = 0;
+};
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: QualityGovernor.h
+  Description: CPU load governor: times each processBlock against its deadline and switches the
+  effects to their cheaper modes under pressure, with hysteresis
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <chrono>
+#include <math.h>
+
+// Load = time spent in processBlock / the block's duration (numSamples / sampleRate). The load follows
+// a rising block at once and falls back with a QUALITY_LOAD_RELEASE_SEC time constant, so one slow
+// block is enough to degrade. Quality comes back only after the load has stayed under the low
+// threshold for QUALITY_RESTORE_HOLD_SEC; the gap between the two thresholds plus the hold stops it
+// toggling every block near the limit.
+//
+// The governor only decides; the effects make the switch click free themselves (the phaser ramps its
+// coefficients, the flanger crossfades its interpolators).
+
+// --- governor constants
+const double QUALITY_HIGH_LOAD = 0.6;			// degrade above this fraction of the deadline
+const double QUALITY_LOW_LOAD = 0.3;			// restore below this
+const double QUALITY_LOAD_RELEASE_SEC = 0.25;	// load meter fall time constant
+const double QUALITY_RESTORE_HOLD_SEC = 1.0;	// time under QUALITY_LOW_LOAD before restoring
+
+class QualityGovernor
+{
+public:
+	QualityGovernor(void) {};
+	~QualityGovernor(void) {};
+
+	/** start at full quality */
+	void reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		load = 0.0;
+		lowTime = 0.0;
+		reduced = false;
+	}
+
+	/** call at the top of processBlock */
+	void beginBlock() { blockStart = std::chrono::steady_clock::now(); }
+
+	/** call at the end of processBlock; returns true while the effects should run in their reduced modes */
+	bool endBlock(int numSamples)
+	{
+		if (numSamples <= 0)
+			return reduced;
+
+		double deadline = numSamples / sampleRate;
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - blockStart).count();
+		double blockLoad = elapsed / deadline;
+
+		// --- instant attack, exponential release
+		double release = exp(-deadline / QUALITY_LOAD_RELEASE_SEC);
+		load = blockLoad > load ? blockLoad : release * load + (1.0 - release) * blockLoad;
+
+		if (load > QUALITY_HIGH_LOAD)
+		{
+			reduced = true;
+			lowTime = 0.0;
+		}
+		else if (reduced && load < QUALITY_LOW_LOAD)
+		{
+			lowTime += deadline;
+			if (lowTime >= QUALITY_RESTORE_HOLD_SEC)
+				reduced = false;
+		}
+		else
+		{
+			lowTime = 0.0;
+		}
+
+		return reduced;
+	}
+
+	/** true while the effects should run in their reduced modes */
+	bool isReduced() { return reduced; }
+
+	/** smoothed load, fraction of the deadline */
+	double getLoad() { return load; }
+
+protected:
+	double sampleRate = 44100.0;
+	std::chrono::steady_clock::time_point blockStart;
+	double load = 0.0;
+	double lowTime = 0.0;	// seconds spent under QUALITY_LOW_LOAD while reduced
+	bool reduced = false;
+};
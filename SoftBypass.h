@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+  Project: Guitar Pedal Emulation Plug-in
+  Author: Jacob Cayetano
+  Framework: JUCE
+  File: SoftBypass.h
+  Description: Click free bypass: crossfades the processed output to the dry input, delayed by the
+  reported latency, and tells the processor when the effects can stop running
+  Contains Code From:
+  --- TheAudioProgrammer
+  --- ASPIK Code Library
+  --- Designing Audio Effect Plugins in C++ by Will C. Pirkle
+  References:
+  --- TheAudioProgrammer (YouTube & GitHub)
+  --- JUCE Framework Documentation
+  --- ASPIK Code Documentation
+  --- Designing Audio Effect Plugins in C++ for AAX, AU, and VST3 with DSP Theory by Will C. Pirkle
+  --- C++: From Control Structures Through Objects (9th Edition) by Tony Gaddis
+  --- Getting Started with JUCE by Martin Robinson
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "fxobjects.h"
+
+// The dry path runs through its own delay line of the processed path's latency, so the host sees the
+// same latency bypassed or not and the crossfade lines up sample for sample.
+//
+//	- processing: pushDry( ) records the input before the effects run in place, mixDry( ) fades the
+//	  processed block toward the delayed dry one (nothing to do once the fade has finished)
+//	- bypassed (isBypassed( )): processBypassed( ) is the whole block, a delay line read and write per
+//	  sample, and the effects are not called at all
+//
+// A fade needs the whole block plus the delay in the history; a longer block than reserve( ) covered
+// jumps straight to the target instead.
+
+// --- bypass constants
+const double BYPASS_FADE_SEC = 0.01;				// crossfade time, either way
+const unsigned int BYPASS_MAX_CHANNELS = 2;
+
+class SoftBypass
+{
+public:
+	SoftBypass(void) {};
+	~SoftBypass(void) {};
+
+	/** allocate the dry history for a latency and block size up front, from arena if given; reset( ) within
+	    those only clears it; NOT realtime safe */
+	void reserve(int maxDelaySamples, int maxBlockSize, MemoryArena* arena = nullptr)
+	{
+		unsigned int length = nextPowerOfTwo((unsigned int)(maxDelaySamples + maxBlockSize + 1));
+		if (length <= capacity)
+			return;
+
+		for (unsigned int c = 0; c < BYPASS_MAX_CHANNELS; c++)
+			dryBuffer[c].allocate(length, arena);
+		capacity = length;
+	}
+
+	/** set the fade rate and the dry delay (the processed path's latency in samples) and clear the history;
+	    allocates only past the reserve( ) size; the fade jumps to the current target, so an instance bypassed before this stays bypassed */
+	void reset(double _sampleRate, int _delaySamples)
+	{
+		delaySamples = _delaySamples > 0 ? _delaySamples : 0;
+		reserve(delaySamples, 1);
+
+		mask = capacity - 1;
+		for (unsigned int c = 0; c < BYPASS_MAX_CHANNELS; c++)
+			memset(&dryBuffer[c][0], 0, capacity * sizeof(float));
+		writeIndex = 0;
+		blockFits = false;
+
+		mixStep = (float)(1.0 / (BYPASS_FADE_SEC * _sampleRate));
+		mix = target;
+	}
+
+	/** fade toward dry (true) or processed (false) from the next block */
+	void setBypassed(bool bypassed) { target = bypassed ? 1.0f : 0.0f; }
+
+	/** true once the fade to dry has finished: call processBypassed( ) instead of the effects */
+	bool isBypassed() { return mix >= 1.0f && target >= 1.0f; }
+
+	/** bypassed block: the dry input through the latency delay, in place; any block size */
+	void processBypassed(float* const* channelData, int numChannels, int numSamples)
+	{
+		numChannels = numChannels < (int)BYPASS_MAX_CHANNELS ? numChannels : BYPASS_MAX_CHANNELS;
+		for (int c = 0; c < numChannels; c++)
+		{
+			float* x = channelData[c];
+			float* dry = &dryBuffer[c][0];
+			for (int n = 0; n < numSamples; n++)
+			{
+				dry[(writeIndex + n) & mask] = x[n];
+				x[n] = dry[(writeIndex + n - delaySamples) & mask];
+			}
+		}
+		writeIndex += numSamples;
+		blockFits = false;
+	}
+
+	/** record the input before the effects overwrite it */
+	void pushDry(const float* const* channelData, int numChannels, int numSamples)
+	{
+		numChannels = numChannels < (int)BYPASS_MAX_CHANNELS ? numChannels : BYPASS_MAX_CHANNELS;
+		for (int c = 0; c < numChannels; c++)
+		{
+			const float* x = channelData[c];
+			float* dry = &dryBuffer[c][0];
+			for (int n = 0; n < numSamples; n++)
+				dry[(writeIndex + n) & mask] = x[n];
+		}
+		blockStart = writeIndex;
+		writeIndex += numSamples;
+
+		// --- the fade reads back numSamples + delaySamples of history
+		blockFits = numSamples + delaySamples < (int)capacity;
+		if (!blockFits)
+			mix = target;
+	}
+
+	/** replace the block from pushDry( ) with the dry input delayed as in processBypassed( ), times gain, for a
+	    block the effects skip so it keeps the processed path's latency; left as is if the block was too long */
+	void readDry(float* const* channelData, int numChannels, int numSamples, float gain)
+	{
+		if (!blockFits)
+			return;
+
+		numChannels = numChannels < (int)BYPASS_MAX_CHANNELS ? numChannels : BYPASS_MAX_CHANNELS;
+		for (int c = 0; c < numChannels; c++)
+		{
+			float* x = channelData[c];
+			const float* dry = &dryBuffer[c][0];
+			for (int n = 0; n < numSamples; n++)
+				x[n] = gain * dry[(blockStart + n - delaySamples) & mask];
+		}
+	}
+
+	/** the numSamples (up to the delay) of dry input just before the block from pushDry( ), times gain: what
+	    a lookahead delay line of the same latency would hold now; returns false if it is not available */
+	bool copyDryHistory(float* const* destination, int numChannels, int numSamples, float gain)
+	{
+		if (!blockFits || numSamples > delaySamples)
+			return false;
+
+		numChannels = numChannels < (int)BYPASS_MAX_CHANNELS ? numChannels : BYPASS_MAX_CHANNELS;
+		for (int c = 0; c < numChannels; c++)
+		{
+			const float* dry = &dryBuffer[c][0];
+			for (int n = 0; n < numSamples; n++)
+				destination[c][n] = gain * dry[(blockStart - numSamples + n) & mask];
+		}
+		return true;
+	}
+
+	/** crossfade the processed block in channelData toward the dry block from pushDry( ) */
+	void mixDry(float* const* channelData, int numChannels, int numSamples)
+	{
+		if (!blockFits || (mix <= 0.0f && target <= 0.0f))
+			return;
+
+		// --- every channel follows the same ramp
+		float mixStart = mix;
+		numChannels = numChannels < (int)BYPASS_MAX_CHANNELS ? numChannels : BYPASS_MAX_CHANNELS;
+		for (int c = 0; c < numChannels; c++)
+		{
+			float* x = channelData[c];
+			const float* dry = &dryBuffer[c][0];
+			mix = mixStart;
+			for (int n = 0; n < numSamples; n++)
+			{
+				if (mix < target)
+					mix = mix + mixStep < target ? mix + mixStep : target;
+				else if (mix > target)
+					mix = mix - mixStep > target ? mix - mixStep : target;
+
+				x[n] += mix * (dry[(blockStart + n - delaySamples) & mask] - x[n]);
+			}
+		}
+	}
+
+protected:
+	ArenaArray<float> dryBuffer[BYPASS_MAX_CHANNELS];	// dry history, power of two long
+	unsigned int capacity = 0;
+	unsigned int mask = 0;
+	unsigned int writeIndex = 0;	// counts samples; wraps through mask
+	unsigned int blockStart = 0;	// writeIndex at the last pushDry( )
+	int delaySamples = 0;
+	bool blockFits = false;			// last pushDry( ) block can be faded
+
+	float mix = 0.0f;				// 0 = processed, 1 = dry
+	float target = 0.0f;
+	float mixStep = 0.0f;
+};
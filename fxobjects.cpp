@@ -57,7 +57,7 @@ float Biquad::getS_value(int channel) // changed to float
 
 - RULES:\n
 1) do all math required to form the output y(n), reading registers as required - do NOT write registers \n
-2) check for underflow, which can happen with feedback structures\n
+2) check for underflow, which can happen with feedback structures (per FX_DENORMAL_MODE)\n
 3) lastly, update the states of the z^-1 registers in the state array just before returning\n
 
 - NOTES:\n
@@ -70,6 +70,9 @@ available on two of the forms: direct and transposed canonical\n
 //double Biquad::processAudioSample(double xn)
 float Biquad::processAudioSample(float xn, int channel, double _sampleRate) // changed to float
 {
+	// --- recursion input, offset in FX_DENORMAL_OFFSET mode
+	xn = addDenormalOffset(xn);
+
 	if (parameters.biquadCalcType == biquadAlgorithm::kDirect)
 	{
 		// --- 1)  form output y(n) = a0*x(n) + a1*x(n-1) + a2*x(n-2) - b1*y(n-1) - b2*y(n-2)
@@ -80,7 +83,7 @@ float Biquad::processAudioSample(float xn, int channel, double _sampleRate) // c
 					coeffArray[b2] * stateArray[channel][y_z2];
 
 		// --- 2) underflow check
-		checkFloatUnderflow(yn);
+		denormalGuard(yn);
 
 		// --- 3) update states
 		stateArray[channel][x_z2] = stateArray[channel][x_z1];
@@ -106,7 +109,7 @@ float Biquad::processAudioSample(float xn, int channel, double _sampleRate) // c
 		float yn = coeffArray[a0] * wn + coeffArray[a1] * stateArray[channel][x_z1] + coeffArray[a2] * stateArray[channel][x_z2]; // changed to float
 
 		// --- 2) underflow check
-		checkFloatUnderflow(yn);
+		denormalGuard(yn);
 
 		// --- 3) update states
 		stateArray[channel][x_z2] = stateArray[channel][x_z1];
@@ -129,7 +132,7 @@ float Biquad::processAudioSample(float xn, int channel, double _sampleRate) // c
 		float yn = coeffArray[a0] * wn + stateArray[channel][x_z1]; // changed to float
 
 		// --- 2) underflow check
-		checkFloatUnderflow(yn);
+		denormalGuard(yn);
 
 		// --- 3) update states
 		stateArray[channel][y_z1] = stateArray[channel][y_z2] - coeffArray[b1] * wn;
@@ -149,7 +152,7 @@ float Biquad::processAudioSample(float xn, int channel, double _sampleRate) // c
 		float yn = coeffArray[a0] * xn + stateArray[channel][x_z1]; // changed to float
 
 		// --- 2) underflow check
-		checkFloatUnderflow(yn);
+		denormalGuard(yn);
 
 		// --- shuffle/update; need to make it so last sample of CH1 does not go into first of CH2
 		stateArray[channel][x_z1] = coeffArray[a1]*xn - coeffArray[b1]*yn + stateArray[channel][x_z2];
@@ -1065,6 +1068,52 @@ const SignalGenData LFO::renderAudioOutput()
 	return output;
 }
 
+/**
+\brief generates several phase-offset normal outputs for one sample interval (multi-voice modulation)
+
+- NOTES:\n
+output k is read at modCounter + phaseOffset + k/numOutputs; the timebase advances once,
+so N voices cost one modulo update plus N cheap waveform evaluations\n
+
+\param outputs array to receive numOutputs bipolar values
+\param numOutputs number of outputs (voices)
+\param phaseOffset extra phase offset in cycles [0.0, +1.0) applied to all outputs
+\param advance false to leave the timebase where it is (another set follows for the same sample period)
+*/
+void LFO::renderMultiPhaseOutput(float* outputs, unsigned int numOutputs, float phaseOffset, bool advance)
+{
+	// --- always first!
+	checkAndWrapModulo(modCounter, phaseInc);
+
+	if (numOutputs == 0)
+	{
+		if (advance)
+			advanceModulo(modCounter, phaseInc);
+		return;
+	}
+
+	float voiceSpacing = 1.0f / (float)numOutputs;
+	generatorWaveform waveform = lfoParameters.waveform;
+
+	for (unsigned int i = 0; i < numOutputs; i++)
+	{
+		// --- offset modulo, wrapped to [0.0, +1.0)
+		float phase = modCounter + phaseOffset + (float)i * voiceSpacing;
+		phase -= (float)(int)phase;
+
+		if (waveform == generatorWaveform::kSin)
+			outputs[i] = parabolicSine(-(phase*2.0f*kPi - kPi));
+		else if (waveform == generatorWaveform::kTriangle)
+			outputs[i] = 2.0f*(float)fabs(unipolarToBipolar(phase)) - 1.0f;
+		else
+			outputs[i] = unipolarToBipolar(phase);
+	}
+
+	// --- setup for next sample period
+	if (advance)
+		advanceModulo(modCounter, phaseInc);
+}
+
 
 #ifdef HAVE_FFTW
 
@@ -20,6 +20,8 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <stdint.h>
 #include <math.h>
 #include "guiconstants.h"
 #include "filters.h"
@@ -41,10 +43,29 @@ const double kSqrtTwo = pow(2.0, 0.5);
 const double kMinFilterFrequency = 20.0;
 const double kMaxFilterFrequency = 20480.0; // 10 octaves above 20 Hz
 const double ARC4RANDOMMAX = 4294967295.0;  // (2^32 - 1)
+const double kMaxSupportedSampleRate = 192000.0; // buffers reserved for this rate are never reallocated by reset( )
+const int kMaxSupportedBlockSize = 8192; // largest host block the reserve( ) functions plan for
 
 #define NEGATIVE       0
 #define POSITIVE       1
 
+// --- denormal protection for the recursive paths (filters, detectors, delay feedback)
+//
+//     FX_DENORMAL_CHECK:  per-sample checkFloatUnderflow( ) on each recursive output (original behavior)
+//     FX_DENORMAL_FTZ:    no per-sample work; relies on flush-to-zero/denormals-are-zero being set by the
+//                         caller for the processing thread (ScopedNoDenormals in processBlock)
+//     FX_DENORMAL_OFFSET: no per-sample branch; adds kDenormalOffset (~ -360 dBFS DC) into the recursions so
+//                         their states never decay into the denormal range, for targets without FTZ/DAZ
+//
+//     the FTZ and OFFSET modes leave the recursive loops branch free so the compiler can vectorize them
+#define FX_DENORMAL_CHECK	0
+#define FX_DENORMAL_FTZ		1
+#define FX_DENORMAL_OFFSET	2
+#ifndef FX_DENORMAL_MODE
+#define FX_DENORMAL_MODE FX_DENORMAL_FTZ
+#endif
+const float kDenormalOffset = 1.0e-18f;	/* inaudible DC for FX_DENORMAL_OFFSET, far above the denormal range */
+
 // ------------------------------------------------------------------ //
 // --- FUNCTIONS ---------------------------------------------------- //
 // ------------------------------------------------------------------ //
@@ -75,6 +96,41 @@ inline bool checkFloatUnderflow(float& value) // changed to float
 	return retValue;
 }
 
+/**
+@denormalGuard
+\ingroup FX-Functions
+
+@brief per-sample underflow protection for a recursive output; compiles to nothing unless
+FX_DENORMAL_MODE is FX_DENORMAL_CHECK
+
+\param value - the value to check for underflow
+*/
+inline void denormalGuard(float& value)
+{
+#if FX_DENORMAL_MODE == FX_DENORMAL_CHECK
+	checkFloatUnderflow(value);
+#endif
+}
+
+/**
+@addDenormalOffset
+\ingroup FX-Functions
+
+@brief adds kDenormalOffset to the input of a recursion when FX_DENORMAL_MODE is FX_DENORMAL_OFFSET,
+otherwise returns the input untouched
+
+\param value - the input to the recursion
+\return the input, plus the offset in FX_DENORMAL_OFFSET mode
+*/
+inline float addDenormalOffset(float value)
+{
+#if FX_DENORMAL_MODE == FX_DENORMAL_OFFSET
+	return value + kDenormalOffset;
+#else
+	return value;
+#endif
+}
+
 /**
 @doLinearInterpolation
 \ingroup FX-Functions
@@ -126,6 +182,23 @@ inline float doLinearInterpolation(float y1, float y2, float fractional_X)
 	return fractional_X * y2 + (1.0 - fractional_X) * y1;
 }
 
+/**
+@nextPowerOfTwo
+\ingroup FX-Functions
+
+@brief smallest power of two >= value (integer loop, no pow( )/log( ) rounding)
+
+\param value - the minimum length
+\return the power of two
+*/
+inline unsigned int nextPowerOfTwo(unsigned int value)
+{
+	unsigned int length = 1;
+	while (length < value)
+		length <<= 1;
+	return length;
+}
+
 /**
 @doLagrangeInterpolation
 \ingroup FX-Functions
@@ -296,6 +369,150 @@ inline double dB2Raw(double dB)
 	return pow(10.0, (dB / 20.0));
 }
 
+/**
+@fastLog2
+\ingroup FX-Functions
+
+@brief branch-free log2(x) approximation for vectorized loops
+
+- NOTES:\n
+splits x = m*2^e with m in [0.707, 1.414), then log2(m) = (2/ln2)*atanh(t), t = (m-1)/(m+1), |t| <= 0.172,
+using the atanh series up to t^7. Max abs error < 2.1e-6 for x in [1e-12, 1e6] (float rounding dominates).
+x must be > 0; the result for x <= 0 is meaningless (caller should select a floor value).\n
+
+\param x - value to convert
+\return log2(x)
+*/
+inline float fastLog2(float x)
+{
+	int32_t bits;
+	memcpy(&bits, &x, sizeof(float));
+
+	// --- exponent, centered so the mantissa lands in [sqrt(0.5), sqrt(2))
+	int32_t e = (bits - 0x3f3504f3) >> 23;
+	bits -= e << 23;
+
+	float m;
+	memcpy(&m, &bits, sizeof(float));
+
+	float t = (m - 1.0f) / (m + 1.0f);
+	float t2 = t*t;
+	return (float)e + t*(2.8853900818f + t2*(0.9617966939f + t2*(0.5770780164f + t2*0.4121985831f)));
+}
+
+/**
+@fastRaw2dB
+\ingroup FX-Functions
+
+@brief calculates dB for given input with fastLog2( ); max abs error < 1.3e-5 dB
+
+\param raw - value to convert to dB, must be > 0
+\return the dB value
+*/
+inline float fastRaw2dB(float raw)
+{
+	// --- 20*log10(x) = 20*log10(2)*log2(x)
+	return 6.0205999133f * fastLog2(raw);
+}
+
+/**
+@fastSqrt
+\ingroup FX-Functions
+
+@brief branch-free sqrt(x) approximation for vectorized loops
+
+- NOTES:\n
+x * rsqrt(x) with the bit-level rsqrt estimate refined by two Newton-Raphson steps;
+max relative error < 4.8e-6 for x in [1e-12, 1e6], and fastSqrt(0) = 0.\n
+
+\param x - value, must be >= 0
+\return sqrt(x)
+*/
+inline float fastSqrt(float x)
+{
+	int32_t bits;
+	memcpy(&bits, &x, sizeof(float));
+	bits = 0x5f375a86 - (bits >> 1);
+
+	float y;
+	memcpy(&y, &bits, sizeof(float));
+
+	float halfX = 0.5f*x;
+	y = y*(1.5f - halfX*y*y);
+	y = y*(1.5f - halfX*y*y);
+	return x*y;
+}
+
+/**
+@fastPow2
+\ingroup FX-Functions
+
+@brief branch-free 2^x approximation for vectorized loops
+
+- NOTES:\n
+splits x into the nearest integer i and f in [-0.5, 0.5], builds 2^i in the exponent bits and
+2^f with a 6th order polynomial; max relative error < 2.5e-7. x is clamped to [-126, +126].\n
+
+\param x - exponent
+\return 2^x
+*/
+inline float fastPow2(float x)
+{
+	x = x < -126.0f ? -126.0f : (x > 126.0f ? 126.0f : x);
+
+	// --- round to nearest without a branch (the cast truncates toward zero)
+	float r = x + 0.5f;
+	int32_t i = (int32_t)r;
+	i -= r < (float)i ? 1 : 0;
+	float f = x - (float)i;
+
+	float p = 1.0f + f*(0.6931471806f + f*(0.2402265070f + f*(0.0555041087f + f*(0.0096181291f + f*(0.0013333558f + f*0.0001540353f)))));
+
+	int32_t bits = (i + 127) << 23;
+	float scale;
+	memcpy(&scale, &bits, sizeof(float));
+	return scale*p;
+}
+
+/**
+@fastdB2Raw
+\ingroup FX-Functions
+
+@brief converts dB to raw value with fastPow2( ); max relative error < 2.5e-7, floor of about -758 dB
+
+\param dB - value to convert to raw
+\return the raw value
+*/
+inline float fastdB2Raw(float dB)
+{
+	// --- 10^(dB/20) = 2^(dB*log2(10)/20)
+	return fastPow2(0.1660964047f * dB);
+}
+
+/**
+@fastTan
+\ingroup FX-Functions
+
+@brief branch-free tan(w) approximation for 0 <= w < pi/2, for prewarping modulated filters
+
+- NOTES:\n
+half-angle form: t = tan(w/2) from the [5/4] Pade approximant (w/2 <= pi/4), then tan(w) = 2t/(1 - t^2).
+w is clamped to [0, 0.49*pi] (fc < 0.49*fs); max relative error < 1e-6 below 0.4*pi, < 6.1e-6 up to 0.49*pi.\n
+
+\param w - angle in radians (e.g. pi*fc/fs)
+\return tan(w)
+*/
+inline float fastTan(float w)
+{
+	const float kMaxAngle = 0.49f * kPi;
+	w = w < 0.0f ? 0.0f : (w > kMaxAngle ? kMaxAngle : w);
+
+	float h = 0.5f*w;
+	float h2 = h*h;
+	float t = h*(945.0f - 105.0f*h2 + h2*h2) / (945.0f - 420.0f*h2 + 15.0f*h2*h2);
+	return 2.0f*t / (1.0f - t*t);
+}
+
 /**
 @peakGainFor_Q
 \ingroup FX-Functions
@@ -1153,6 +1370,122 @@ inline bool resample(double* input, double* output, uint32_t inLength, uint32_t
 	return true;
 }
 
+// ------------------------------------------------------------------ //
+// --- MEMORY ------------------------------------------------------- //
+// ------------------------------------------------------------------ //
+
+// --- constants for MemoryArena
+const size_t ARENA_ALIGNMENT = 64;				///< every allocation starts on a cache line
+const size_t ARENA_DEFAULT_CHUNK_SIZE = 262144;	///< bytes per chunk (256 kB)
+
+/**
+\class MemoryArena
+\ingroup FX-Objects
+\brief
+The MemoryArena object hands out ARENA_ALIGNMENT aligned storage from a few large chunks, so the buffers of
+one plugin instance's effect chain sit together in memory instead of scattered across the heap.
+
+- allocations are bump-pointer and are never freed one by one; the chunks are released with the arena
+- a request that does not fit in the current chunk starts a new one (at least the request size), so
+pointers already handed out never move
+- allocate( ) is NOT realtime safe (a new chunk may be needed): request storage from reserve( ) functions
+or reset( ), never from the audio callback
+
+Control I/F:
+- attach with the reserve( ) functions of the objects that support it; the arena must outlive them.
+*/
+class MemoryArena
+{
+public:
+	MemoryArena(size_t _chunkSize = ARENA_DEFAULT_CHUNK_SIZE) : chunkSize(_chunkSize) {}	/* C-TOR */
+	~MemoryArena() {}	/* D-TOR */
+
+	/** aligned storage for count objects of type T (not initialized) */
+	template <typename T>
+	T* allocate(size_t count)
+	{
+		return reinterpret_cast<T*>(allocateBytes(count * sizeof(T)));
+	}
+
+	/** bytes handed out so far (with alignment padding) */
+	size_t getBytesUsed() { return bytesUsed; }
+
+	/** bytes held in chunks */
+	size_t getBytesReserved() { return bytesReserved; }
+
+protected:
+	/** bump allocate, rounded up to ARENA_ALIGNMENT so the next allocation stays aligned */
+	uint8_t* allocateBytes(size_t bytes)
+	{
+		bytes = (bytes + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+		if (bytes == 0)
+			bytes = ARENA_ALIGNMENT;
+
+		if (!current || bytes > (size_t)(end - current))
+		{
+			// --- new chunk, over-allocated so it can start on an aligned address
+			size_t size = bytes > chunkSize ? bytes : chunkSize;
+			std::unique_ptr<uint8_t[]> chunk(new uint8_t[size + ARENA_ALIGNMENT - 1]);
+			uintptr_t address = reinterpret_cast<uintptr_t>(chunk.get());
+			current = chunk.get() + ((ARENA_ALIGNMENT - (address & (ARENA_ALIGNMENT - 1))) & (ARENA_ALIGNMENT - 1));
+			end = current + size;
+			chunks.push_back(std::move(chunk));
+			bytesReserved += size;
+		}
+
+		uint8_t* block = current;
+		current += bytes;
+		bytesUsed += bytes;
+		return block;
+	}
+
+	size_t chunkSize = ARENA_DEFAULT_CHUNK_SIZE;
+	std::vector<std::unique_ptr<uint8_t[]>> chunks;	///< owned storage
+	uint8_t* current = nullptr;						///< next free byte in the newest chunk
+	uint8_t* end = nullptr;							///< end of the newest chunk
+	size_t bytesUsed = 0;
+	size_t bytesReserved = 0;
+};
+
+/**
+\class ArenaArray
+\ingroup FX-Objects
+\brief
+Array storage that comes from a MemoryArena when one is given and from the heap otherwise; it stands in for
+std::unique_ptr<T[]> in objects that can be attached to an arena (indexing and bool test are the same).
+*/
+template <typename T>
+class ArenaArray
+{
+public:
+	ArenaArray() {}		/* C-TOR */
+	~ArenaArray() {}	/* D-TOR */
+
+	/** (re)allocate count elements, from the arena if there is one; NOT realtime safe */
+	void allocate(size_t count, MemoryArena* arena)
+	{
+		if (arena)
+		{
+			owned.reset();
+			data = arena->allocate<T>(count);
+		}
+		else
+		{
+			owned.reset(new T[count]);
+			data = owned.get();
+		}
+	}
+
+	T& operator[](size_t index) { return data[index]; }
+	const T& operator[](size_t index) const { return data[index]; }
+	T* get() { return data; }
+	explicit operator bool() const { return data != nullptr; }
+
+private:
+	std::unique_ptr<T[]> owned = nullptr;	///< heap storage when there is no arena
+	T* data = nullptr;
+};
+
 // ------------------------------------------------------------------ //
 // --- INTERFACES --------------------------------------------------- //
 // ------------------------------------------------------------------ //
@@ -1762,7 +2095,7 @@ public:
 	\param xn input
 	\return the processed sample
 	*/
-	virtual double processAudioSample(double xn)
+	virtual float processAudioSample(float xn, int channel, double _sampleRate) // changed to float
 	{
 		return xn;
 	}
@@ -1818,131 +2151,563 @@ protected:
 	LRFilterBankParameters parameters; ///< parameters for the object
 };
 
-// --- constants
-const unsigned int TLD_AUDIO_DETECT_MODE_PEAK = 0;
-const unsigned int TLD_AUDIO_DETECT_MODE_MS = 1;
-const unsigned int TLD_AUDIO_DETECT_MODE_RMS = 2;
-const double TLD_AUDIO_ENVELOPE_ANALOG_TC = -0.99967234081320612357829304641019; // ln(36.7%)
+// --- constants for LRFilterBankN
+const unsigned int LR_MAX_BANDS = 8;			///< max bands (LR_MAX_BANDS - 1 crossovers)
+const int LR_BLOCK_SIZE = 64;					///< sub-block size (stack scratch buffers)
 
 /**
-\struct AudioDetectorParameters
+\struct LRFilterBankNParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the AudioDetector object. NOTE: this object uses constant defintions:
-
-- const unsigned int TLD_AUDIO_DETECT_MODE_PEAK = 0;
-- const unsigned int TLD_AUDIO_DETECT_MODE_MS = 1;
-- const unsigned int TLD_AUDIO_DETECT_MODE_RMS = 2;
-- const double TLD_AUDIO_ENVELOPE_ANALOG_TC = -0.99967234081320612357829304641019; // ln(36.7%)
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
+Custom parameter structure for the LRFilterBankN object: band count and the crossover frequencies,
+lowest first.
 */
-struct AudioDetectorParameters
+struct LRFilterBankNParameters
 {
-	AudioDetectorParameters() {}
+	LRFilterBankNParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	AudioDetectorParameters& operator=(const AudioDetectorParameters& params)	// need this override for collections to work
+	LRFilterBankNParameters& operator=(const LRFilterBankNParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
-		attackTime_mSec = params.attackTime_mSec;
-		releaseTime_mSec = params.releaseTime_mSec;
-		detectMode = params.detectMode;
-		detect_dB = params.detect_dB;
-		clampToUnityMax = params.clampToUnityMax;
+
+		numBands = params.numBands;
+		for (unsigned int i = 0; i < LR_MAX_BANDS - 1; i++)
+			splitFrequency[i] = params.splitFrequency[i];
+
 		return *this;
 	}
 
 	// --- individual parameters
-	double attackTime_mSec = 0.0; ///< attack time in milliseconds
-	double releaseTime_mSec = 0.0;///< release time in milliseconds
-	unsigned int  detectMode = 0;///< detect mode, see TLD_ constants above
-	bool detect_dB = false;	///< detect in dB  DEFAULT  = false (linear NOT log)
-	bool clampToUnityMax = true;///< clamp output to 1.0 (set false for true log detectors)
+	unsigned int numBands = 3;		///< number of bands, 1 to LR_MAX_BANDS
+	double splitFrequency[LR_MAX_BANDS - 1] = { 250.0, 2500.0, 5000.0, 8000.0, 11000.0, 14000.0, 17000.0 }; ///< crossovers (Hz), ascending; the first numBands - 1 are used
 };
 
 /**
-\class AudioDetector
+\struct LRBiquadCoeffs
 \ingroup FX-Objects
 \brief
-The AudioDetector object implements the audio detector defined in the book source below.
-NOTE: this detector can receive signals and transmit detection values that are both > 0dBFS
+Coefficients of one normalized biquad section (a0 = 1) for the LRFilterBankN block filters.
+*/
+struct LRBiquadCoeffs
+{
+	float b0 = 1.0f;
+	float b1 = 0.0f;
+	float b2 = 0.0f;
+	float a1 = 0.0f;
+	float a2 = 0.0f;
+};
+
+/**
+\class LRFilterBankN
+\ingroup FX-Objects
+\brief
+The LRFilterBankN object splits the input into N bands with a tree of 4th order Linkwitz-Riley crossovers
+and processes whole blocks into per-band buffers.
+
+- the tree splits the input at the lowest crossover, then splits the high side again, and so on
+- LR4 low + high = a 2nd order allpass at the crossover, so each band is also run through the allpasses of the
+crossovers above its own (allpass phase compensation): every band then carries the same total phase and the
+bands sum to the input through that allpass chain, with a flat magnitude response
+- biquads are transposed canonical sections on channel-interleaved blocks; the inner loop is over the
+Channels lanes with no branches, so the compiler can map the channels onto vector registers
 
 Audio I/O:
-- Processes mono input to a detected signal output.
+- Processes Channels-channel blocks into numBands x Channels band buffers.
+NOTE: processAudioSample( ) is inoperable and only returns the input back.
 
 Control I/F:
-- Use AudioDetectorParameters structure to get/set object params.
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
+- Use LRFilterBankNParameters structure to get/set object params.
 */
-class AudioDetector : public IAudioSignalProcessor
+template <unsigned int Channels = 2>
+class LRFilterBankN : public IAudioSignalProcessor
 {
 public:
-	AudioDetector() {}	/* C-TOR */
-	~AudioDetector() {}	/* D-TOR */
+	LRFilterBankN() {
+		calculateFilterCoeffs();
+	}		/* C-TOR */
+	~LRFilterBankN() {}		/* D-TOR */
 
-public:
-	/** set sample rate dependent time constants and clear last envelope output value */
+	/** reset: clear every section of every channel (the channel argument is ignored) */
 	virtual bool reset(double _sampleRate, int channel)
 	{
-		setSampleRate(_sampleRate);
-		lastEnvelope = 0.0;
+		sampleRate = _sampleRate;
+		memset(state, 0, sizeof(state));
+		memset(compensationState, 0, sizeof(compensationState));
+		calculateFilterCoeffs();
 		return true;
 	}
 
-	/** return false: this object only processes samples */
+	/** return false: this object only processes blocks */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	// --- process audio: detect the log envelope and return it in dB
+	/** this does nothing for this object, see processAudioBlock( ) below */
+	virtual float processAudioSample(float xn, int channel, double _sampleRate) { return xn; }
+
+	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\param xn input
-	\return the processed sample
+	\return LRFilterBankNParameters custom data structure
 	*/
-	virtual float processAudioSample(float xn, int channel, double _sampleRate) // changed to float
-	//virtual double processAudioSample(double xn)
+	LRFilterBankNParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param LRFilterBankNParameters custom data structure
+	*/
+	void setParameters(const LRFilterBankNParameters& _parameters)
 	{
-		// --- all modes do Full Wave Rectification
-		//double input = fabs(xn);
-		float input = fabs(xn); // changed to float
+		parameters = _parameters;
+		parameters.numBands = parameters.numBands < 1 ? 1 : (parameters.numBands > LR_MAX_BANDS ? LR_MAX_BANDS : parameters.numBands);
+		calculateFilterCoeffs();
+	}
 
-		// --- square it for MS and RMS
-		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_MS ||
-			audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
-			input *= input;
+	/** number of bands in use */
+	unsigned int getNumBands() { return parameters.numBands; }
 
-		// --- to store current
-		//double currEnvelope = 0.0;
-		float currEnvelope = 0.0; // changed to float
+	/** split a block into bands */
+	/**
+	\param input Channels input buffers
+	\param bandData bandData[band][channel] output buffers, numBands x Channels; may be the input buffers (each sub-block is read before any band is written)
+	\param numSamples number of samples in the block
+	*/
+	void processAudioBlock(const float* const* input, float* const* const* bandData, int numSamples)
+	{
+		float rest[LR_BLOCK_SIZE * Channels];
+		float low[LR_BLOCK_SIZE * Channels];
+		const unsigned int numSplits = parameters.numBands - 1;
 
-		// --- do the detection with attack or release applied
-		if (input > lastEnvelope)
-			currEnvelope = attackTime * (lastEnvelope - input) + input;
-		else
-			currEnvelope = releaseTime * (lastEnvelope - input) + input;
+		for (int start = 0; start < numSamples; start += LR_BLOCK_SIZE)
+		{
+			const int count = numSamples - start < LR_BLOCK_SIZE ? numSamples - start : LR_BLOCK_SIZE;
 
-		// --- we are recursive so need to check underflow
-		checkFloatUnderflow(currEnvelope);
+			// --- interleave: [sample][channel]
+			for (unsigned int c = 0; c < Channels; c++)
+				for (int n = 0; n < count; n++)
+					rest[n * Channels + c] = input[c][start + n];
 
-		// --- bound them; can happen when using pre-detector gains of more than 1.0
-		if (audioDetectorParameters.clampToUnityMax)
-			currEnvelope = fmin(currEnvelope, 1.0);
+			for (unsigned int k = 0; k < numSplits; k++)
+			{
+				// --- low band of this split, high side continues up the tree
+				processSection(lowpass[k][0], state[k][0], rest, low, count);
+				processSection(lowpass[k][1], state[k][1], low, low, count);
+				processSection(highpass[k][0], state[k][2], rest, rest, count);
+				processSection(highpass[k][1], state[k][3], rest, rest, count);
 
-		// --- can not be (-)
-		currEnvelope = fmax(currEnvelope, 0.0);
+				// --- phase compensation: the allpasses of the crossovers above this band
+				for (unsigned int j = k + 1; j < numSplits; j++)
+					processSection(allpass[j], compensationState[k][j], low, low, count);
 
-		// --- store envelope prior to sqrt for RMS version
-		lastEnvelope = currEnvelope;
+				deinterleave(low, bandData[k], start, count);
+			}
 
-		// --- if RMS, do the SQRT
-		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
-			currEnvelope = pow(currEnvelope, 0.5);
+			// --- the top band is what is left
+			deinterleave(rest, bandData[numSplits], start, count);
+		}
+	}
+
+protected:
+	/** Butterworth (Q = 0.707) LP/HP pairs and the matching allpass for each crossover, bilinear with prewarping */
+	void calculateFilterCoeffs()
+	{
+		for (unsigned int k = 0; k < LR_MAX_BANDS - 1; k++)
+		{
+			double fc = parameters.splitFrequency[k];
+			fc = fc < 1.0 ? 1.0 : (fc > 0.49 * sampleRate ? 0.49 * sampleRate : fc);
+
+			double K = tan(kPi * fc / sampleRate);
+			double KK = K * K;
+			double norm = 1.0 / (1.0 + kSqrtTwo * K + KK);
+			double a1 = 2.0 * (KK - 1.0) * norm;
+			double a2 = (1.0 - kSqrtTwo * K + KK) * norm;
+
+			LRBiquadCoeffs lp, hp, ap;
+			lp.b0 = (float)(KK * norm);
+			lp.b1 = (float)(2.0 * KK * norm);
+			lp.b2 = (float)(KK * norm);
+			hp.b0 = (float)norm;
+			hp.b1 = (float)(-2.0 * norm);
+			hp.b2 = (float)norm;
+			ap.b0 = (float)a2;
+			ap.b1 = (float)a1;
+			ap.b2 = 1.0f;
+			lp.a1 = hp.a1 = ap.a1 = (float)a1;
+			lp.a2 = hp.a2 = ap.a2 = (float)a2;
+
+			lowpass[k][0] = lowpass[k][1] = lp;
+			highpass[k][0] = highpass[k][1] = hp;
+			allpass[k] = ap;
+		}
+	}
+
+	/** one biquad over an interleaved block, all channels at once; in place is fine */
+	static void processSection(const LRBiquadCoeffs& coeffs, float (&z)[2][Channels], const float* input, float* output, int count)
+	{
+		const float b0 = coeffs.b0, b1 = coeffs.b1, b2 = coeffs.b2, a1 = coeffs.a1, a2 = coeffs.a2;
+		float z1[Channels];
+		float z2[Channels];
+		for (unsigned int c = 0; c < Channels; c++)
+		{
+			z1[c] = z[0][c];
+			z2[c] = z[1][c];
+		}
+
+		for (int n = 0; n < count; n++)
+		{
+			const float* x = input + n * Channels;
+			float* y = output + n * Channels;
+			for (unsigned int c = 0; c < Channels; c++)
+			{
+				float xn = x[c];
+				float yn = b0 * xn + z1[c];
+				z1[c] = b1 * xn - a1 * yn + z2[c];
+				z2[c] = b2 * xn - a2 * yn;
+				y[c] = yn;
+			}
+		}
+
+		for (unsigned int c = 0; c < Channels; c++)
+		{
+			z[0][c] = z1[c];
+			z[1][c] = z2[c];
+		}
+	}
+
+	/** interleaved block back out to the per-channel band buffers */
+	static void deinterleave(const float* block, float* const* output, int start, int count)
+	{
+		for (unsigned int c = 0; c < Channels; c++)
+			for (int n = 0; n < count; n++)
+				output[c][start + n] = block[n * Channels + c];
+	}
+
+	LRFilterBankNParameters parameters;	///< parameters for the object
+	double sampleRate = 44100.0;		///< current sample rate
+
+	// --- per crossover: LR4 = two identical Butterworth sections each side, plus its allpass
+	LRBiquadCoeffs lowpass[LR_MAX_BANDS - 1][2];
+	LRBiquadCoeffs highpass[LR_MAX_BANDS - 1][2];
+	LRBiquadCoeffs allpass[LR_MAX_BANDS - 1];
+
+	// --- section state [crossover][section: LP1, LP2, HP1, HP2][z1/z2][channel]
+	float state[LR_MAX_BANDS - 1][4][2][Channels] = { { { { 0.0f } } } };
+	// --- compensation allpass state [band][crossover][z1/z2][channel]
+	float compensationState[LR_MAX_BANDS - 1][LR_MAX_BANDS - 1][2][Channels] = { { { { 0.0f } } } };
+};
+
+// --- constants for BandSplitter
+const unsigned int BANDSPLIT_MAX_CHANNELS = 2;	///< channels the crossover runs in one pass
+const int BANDSPLIT_DEFAULT_BLOCK_SIZE = 512;	///< block size allocated until setMaxBlockSize( ) is called
+
+/**
+\struct BandSplitterParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the BandSplitter object.
+*/
+struct BandSplitterParameters
+{
+	BandSplitterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	BandSplitterParameters& operator=(const BandSplitterParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		enableSplit = params.enableSplit;
+		splitFrequency_Hz = params.splitFrequency_Hz;
+		return *this;
+	}
+
+	// --- individual parameters
+	bool enableSplit = false;			///< process only above the split, leave the lows dry
+	double splitFrequency_Hz = 200.0;	///< crossover frequency (Hz)
+};
+
+/**
+\class BandSplitter
+\ingroup FX-Objects
+\brief
+The BandSplitter object puts an effect above a crossover frequency only: split( ) leaves the highs in the
+channel buffers for the effect and holds the lows, recombine( ) adds the dry lows back afterwards.
+
+- the crossover is a 2 band LRFilterBankN (LR4), so the whole split is one pass over the block with the
+channels in vector lanes; the lows and highs both carry the crossover's allpass phase, so with the effect
+bypassed the recombined output has a flat magnitude response
+- when the split is disabled split( ) and recombine( ) do nothing and the effect sees the full band
+
+Audio I/O:
+- Processes blocks of up to BANDSPLIT_MAX_CHANNELS channels in place.
+NOTE: processAudioSample( ) is inoperable and only returns the input back.
+
+Control I/F:
+- Use BandSplitterParameters structure to get/set object params.
+*/
+class BandSplitter : public IAudioSignalProcessor
+{
+public:
+	BandSplitter() {}		/* C-TOR */
+	~BandSplitter() {}		/* D-TOR */
+
+	/** largest block split( ) will be given; takes effect on the next reset( ) */
+	void setMaxBlockSize(int _maxBlockSize) { maxBlockSize = _maxBlockSize > 0 ? _maxBlockSize : 1; }
+
+	/** allocate the buffers for blocks up to _maxBlockSize up front, from _arena if given; reset( ) for
+	    blocks that fit only clears memory. NOT realtime safe */
+	void reserve(int _maxBlockSize, MemoryArena* _arena = nullptr)
+	{
+		if (_arena)
+			arena = _arena;
+		if (_maxBlockSize <= allocatedBlockSize)
+			return;
+
+		// --- one buffer per channel for the lows, one for the highs of a missing (mono) channel
+		for (unsigned int c = 0; c < BANDSPLIT_MAX_CHANNELS; c++)
+			lowBuffer[c].allocate(_maxBlockSize, arena);
+		spareBuffer.allocate(_maxBlockSize, arena);
+		allocatedBlockSize = _maxBlockSize;
+	}
+
+	/** size the low band buffers and clear the crossover; allocates only past the reserve( ) size */
+	virtual bool reset(double _sampleRate, int channel)
+	{
+		sampleRate = _sampleRate;
+		crossover.reset(sampleRate, channel);
+		crossover.setParameters(crossoverParameters());
+
+		reserve(maxBlockSize);
+		for (unsigned int c = 0; c < BANDSPLIT_MAX_CHANNELS; c++)
+			memset(&lowBuffer[c][0], 0, allocatedBlockSize * sizeof(float));
+		splitSamples = 0;
+		return true;
+	}
+
+	/** return false: this object only processes blocks */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** this does nothing for this object, see split( ) and recombine( ) below */
+	virtual float processAudioSample(float xn, int channel, double _sampleRate) { return xn; }
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return BandSplitterParameters custom data structure
+	*/
+	BandSplitterParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param BandSplitterParameters custom data structure
+	*/
+	void setParameters(const BandSplitterParameters& _parameters)
+	{
+		bool enabling = _parameters.enableSplit && !parameters.enableSplit;
+		bool retune = _parameters.splitFrequency_Hz != parameters.splitFrequency_Hz;
+		parameters = _parameters;
+
+		// --- coefficients only when the frequency moves; state from the last time it ran is stale
+		if (retune)
+			crossover.setParameters(crossoverParameters());
+		if (enabling)
+			crossover.reset(sampleRate, 0);
+	}
+
+	/** split a block in place: the channel buffers keep the highs for the effect, the lows are held for recombine( ) */
+	/**
+	\param channelData channel buffers, processed in place
+	\param numChannels number of channels; those past BANDSPLIT_MAX_CHANNELS are left full band
+	\param numSamples number of samples, up to the block size given to setMaxBlockSize( )
+	*/
+	void split(float* const* channelData, int numChannels, int numSamples)
+	{
+		if (!parameters.enableSplit || numChannels < 1 || numSamples > allocatedBlockSize)
+			return;
+
+		// --- a mono block runs through both lanes, the second into the spare buffer
+		const float* input[BANDSPLIT_MAX_CHANNELS];
+		float* low[BANDSPLIT_MAX_CHANNELS];
+		float* high[BANDSPLIT_MAX_CHANNELS];
+		for (unsigned int c = 0; c < BANDSPLIT_MAX_CHANNELS; c++)
+		{
+			bool present = (int)c < numChannels;
+			input[c] = channelData[present ? c : 0];
+			low[c] = &lowBuffer[c][0];
+			high[c] = present ? channelData[c] : &spareBuffer[0];
+		}
+		float* const* bands[2] = { low, high };
+
+		crossover.processAudioBlock(input, bands, numSamples);
+		splitSamples = numSamples;
+	}
+
+	/** add the dry lows held by split( ) back into the processed highs */
+	/**
+	\param channelData channel buffers, processed in place
+	\param numChannels number of channels, as given to split( )
+	\param numSamples number of samples, as given to split( )
+	*/
+	void recombine(float* const* channelData, int numChannels, int numSamples)
+	{
+		if (!parameters.enableSplit || numSamples != splitSamples)
+			return;
+
+		numChannels = numChannels > (int)BANDSPLIT_MAX_CHANNELS ? (int)BANDSPLIT_MAX_CHANNELS : numChannels;
+		for (int c = 0; c < numChannels; c++)
+		{
+			float* output = channelData[c];
+			const float* low = &lowBuffer[c][0];
+			for (int n = 0; n < numSamples; n++)
+				output[n] += low[n];
+		}
+		splitSamples = 0;
+	}
+
+protected:
+	/** 2 band crossover at the split frequency */
+	LRFilterBankNParameters crossoverParameters()
+	{
+		LRFilterBankNParameters params;
+		params.numBands = 2;
+		params.splitFrequency[0] = parameters.splitFrequency_Hz;
+		return params;
+	}
+
+	BandSplitterParameters parameters;			///< parameters for the object
+	LRFilterBankN<BANDSPLIT_MAX_CHANNELS> crossover;	///< LR4 crossover
+	double sampleRate = 44100.0;				///< current sample rate
+
+	// --- buffers, allocated in reset( )
+	ArenaArray<float> lowBuffer[BANDSPLIT_MAX_CHANNELS];	///< lows held between split( ) and recombine( )
+	ArenaArray<float> spareBuffer;						///< highs of the missing channel for mono blocks
+	MemoryArena* arena = nullptr;						///< storage source, if any
+	int maxBlockSize = BANDSPLIT_DEFAULT_BLOCK_SIZE;
+	int allocatedBlockSize = 0;					///< allocated length; only grows (see reserve( ))
+	int splitSamples = 0;						///< samples split( ) holds for recombine( )
+};
+
+// --- constants
+const unsigned int TLD_AUDIO_DETECT_MODE_PEAK = 0;
+const unsigned int TLD_AUDIO_DETECT_MODE_MS = 1;
+const unsigned int TLD_AUDIO_DETECT_MODE_RMS = 2;
+const double TLD_AUDIO_ENVELOPE_ANALOG_TC = -0.99967234081320612357829304641019; // ln(36.7%)
+
+/**
+\struct AudioDetectorParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the AudioDetector object. NOTE: this object uses constant defintions:
+
+- const unsigned int TLD_AUDIO_DETECT_MODE_PEAK = 0;
+- const unsigned int TLD_AUDIO_DETECT_MODE_MS = 1;
+- const unsigned int TLD_AUDIO_DETECT_MODE_RMS = 2;
+- const double TLD_AUDIO_ENVELOPE_ANALOG_TC = -0.99967234081320612357829304641019; // ln(36.7%)
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct AudioDetectorParameters
+{
+	AudioDetectorParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	AudioDetectorParameters& operator=(const AudioDetectorParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+		attackTime_mSec = params.attackTime_mSec;
+		releaseTime_mSec = params.releaseTime_mSec;
+		detectMode = params.detectMode;
+		detect_dB = params.detect_dB;
+		clampToUnityMax = params.clampToUnityMax;
+		return *this;
+	}
+
+	// --- individual parameters
+	double attackTime_mSec = 0.0; ///< attack time in milliseconds
+	double releaseTime_mSec = 0.0;///< release time in milliseconds
+	unsigned int  detectMode = 0;///< detect mode, see TLD_ constants above
+	bool detect_dB = false;	///< detect in dB  DEFAULT  = false (linear NOT log)
+	bool clampToUnityMax = true;///< clamp output to 1.0 (set false for true log detectors)
+};
+
+/**
+\class AudioDetector
+\ingroup FX-Objects
+\brief
+The AudioDetector object implements the audio detector defined in the book source below.
+NOTE: this detector can receive signals and transmit detection values that are both > 0dBFS
+
+Audio I/O:
+- Processes mono input to a detected signal output.
+
+Control I/F:
+- Use AudioDetectorParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class AudioDetector : public IAudioSignalProcessor
+{
+public:
+	AudioDetector() {}	/* C-TOR */
+	~AudioDetector() {}	/* D-TOR */
+
+public:
+	/** set sample rate dependent time constants and clear last envelope output value */
+	virtual bool reset(double _sampleRate, int channel)
+	{
+		setSampleRate(_sampleRate);
+		lastEnvelope = 0.0;
+		return true;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	// --- process audio: detect the log envelope and return it in dB
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual float processAudioSample(float xn, int channel, double _sampleRate) // changed to float
+	//virtual double processAudioSample(double xn)
+	{
+		// --- all modes do Full Wave Rectification
+		//double input = fabs(xn);
+		float input = fabs(xn); // changed to float
+
+		// --- square it for MS and RMS
+		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_MS ||
+			audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
+			input *= input;
+
+		// --- to store current
+		//double currEnvelope = 0.0;
+		float currEnvelope = 0.0; // changed to float
+
+		// --- do the detection with attack or release applied
+		if (input > lastEnvelope)
+			currEnvelope = attackTime * (lastEnvelope - input) + input;
+		else
+			currEnvelope = releaseTime * (lastEnvelope - input) + input;
+
+		// --- we are recursive so need to check underflow
+		denormalGuard(currEnvelope);
+
+		// --- bound them; can happen when using pre-detector gains of more than 1.0
+		if (audioDetectorParameters.clampToUnityMax)
+			currEnvelope = fmin(currEnvelope, 1.0);
+
+		// --- can not be (-)
+		currEnvelope = fmax(currEnvelope, 0.0);
+
+		// --- store envelope prior to sqrt for RMS version
+		lastEnvelope = currEnvelope;
+
+		// --- if RMS, do the SQRT
+		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
+			currEnvelope = pow(currEnvelope, 0.5);
 
 		// --- if not dB, we are done
 		if (!audioDetectorParameters.detect_dB)
@@ -1958,6 +2723,71 @@ public:
 		return 20.0*log10(currEnvelope);
 	}
 
+	/** process a block: detect the envelope of input[] into output[], same units as processAudioSample( ) */
+	/**
+	- NOTES:\n
+	rectify/square and the sqrt/dB conversion are separate loops over the block that vectorize; only the
+	envelope recursion is serial, and its attack/release choice is a select (blend) rather than a branch.
+	Uses fastSqrt( ) and fastLog2( ), so RMS and dB outputs differ from processAudioSample( ) by < 1.3e-5 dB.
+	RMS in dB skips the sqrt entirely: 20*log10(sqrt(x)) = 10*log10(x).\n
+
+	\param input input samples
+	\param output detector output; may be the same array as input
+	\param numSamples number of samples in the block
+	*/
+	void processAudioBlock(const float* input, float* output, int numSamples)
+	{
+		const bool squared = audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_MS ||
+							 audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS;
+		const bool rms = audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS;
+
+		// --- 1) full wave rectify, square for MS and RMS
+		const float squareMix = squared ? 1.0f : 0.0f;
+		for (int n = 0; n < numSamples; n++)
+		{
+			float x = fabsf(input[n]);
+			output[n] = x * (1.0f + squareMix * (x - 1.0f));
+		}
+
+		// --- 2) envelope with attack or release applied
+		//     (state stays double like lastEnvelope, so the envelope matches processAudioSample( ))
+		const double maxEnvelope = audioDetectorParameters.clampToUnityMax ? 1.0 : 1.0e34;
+		double envelope = lastEnvelope;
+		for (int n = 0; n < numSamples; n++)
+		{
+			double x = output[n];
+			double coeff = x > envelope ? attackTime : releaseTime;
+			envelope = coeff * (envelope - x) + x;
+			envelope = envelope < maxEnvelope ? envelope : maxEnvelope;
+			envelope = envelope > 0.0 ? envelope : 0.0;
+			output[n] = (float)envelope;
+		}
+
+		// --- recursive, so check underflow (once per block)
+		float lastValue = (float)envelope;
+		if (checkFloatUnderflow(lastValue))
+			envelope = 0.0;
+		lastEnvelope = envelope;
+
+		// --- 3) convert: linear RMS needs the sqrt, dB modes need the log
+		if (!audioDetectorParameters.detect_dB)
+		{
+			if (rms)
+			{
+				for (int n = 0; n < numSamples; n++)
+					output[n] = fastSqrt(output[n]);
+			}
+			return;
+		}
+
+		const float dBScale = rms ? 3.0102999566f : 6.0205999133f; // 10*log10(2) or 20*log10(2)
+		for (int n = 0; n < numSamples; n++)
+		{
+			float x = output[n];
+			output[n] = x > 0.0f ? dBScale * fastLog2(x) : -96.0f;
+		}
+	}
+
 	/** get parameters: note use of custom structure for passing param data */
 	/**
 	\return AudioDetectorParameters custom data structure
@@ -2028,6 +2858,26 @@ Use this strongly typed enum to set the dynamics processor type.
 // --- processorType
 enum class dynamicsProcessorType { kCompressor, kDownwardExpander };
 
+// --- constants for DynamicsProcessor block processing
+const int DYNAMICS_BLOCK_SIZE = 64;						///< sub-block size for the block engine (stack scratch buffers)
+const double DYNAMICS_MAX_LOOKAHEAD_MSEC = 20.0;		///< size of the lookahead delay line
+const unsigned int DYNAMICS_GAIN_TABLE_SIZE = 1025;		///< gain computer table points
+const float DYNAMICS_GAIN_TABLE_RANGE_dB = 128.0f;		///< table spans threshold +/- this range
+const float DYNAMICS_GAIN_TABLE_FLOOR_dB = -240.0f;		///< gate/expander floor stored in the table
+const unsigned int DYNAMICS_MAX_CHANNELS = 8;			///< max channels for linked frame/block processing and the sidechain bus
+
+/**
+\enum dynamicsLinkMode
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to set how linked (multichannel) detection combines the channels.
+
+- enum class dynamicsLinkMode { kMax, kMean };
+- kMax: loudest channel drives the detector
+- kMean: RMS across channels (power average) drives the detector
+*/
+enum class dynamicsLinkMode { kMax, kMean };
+
 
 /**
 \struct DynamicsProcessorParameters
@@ -2059,6 +2909,8 @@ struct DynamicsProcessorParameters
 		attackTime_mSec = params.attackTime_mSec;
 		releaseTime_mSec = params.releaseTime_mSec;
 		outputGain_dB = params.outputGain_dB;
+		lookahead_mSec = params.lookahead_mSec;
+		linkMode = params.linkMode;
 		// --- NOTE: do not set outbound variables??
 		gainReduction = params.gainReduction;
 		gainReduction_dB = params.gainReduction_dB;
@@ -2076,6 +2928,8 @@ struct DynamicsProcessorParameters
 	double attackTime_mSec = 0.0;		///< attack mSec
 	double releaseTime_mSec = 0.0;		///< release mSec
 	double outputGain_dB = 0.0;			///< make up gain
+	double lookahead_mSec = 0.0;		///< audio delay ahead of the detector (adds this much latency); max DYNAMICS_MAX_LOOKAHEAD_MSEC
+	dynamicsLinkMode linkMode = dynamicsLinkMode::kMax; ///< channel combining for linked detection (frame/multichannel block)
 
 	// --- outbound values, for owner to use gain-reduction metering
 	double gainReduction = 1.0;			///< output value for gain reduction that occurred
@@ -2090,6 +2944,11 @@ The DynamicsProcessor object implements a dynamics processor suite: compressor,
 
 Audio I/O:
 - Processes mono input to mono output.
+- processAudioBlock( ) is the block engine: detector block, table gain computer in dB,
+  one vectorized dB-to-linear pass, optional lookahead delay, then the DCA.
+- processAudioFrame( ) and the multichannel processAudioBlock( ) are stereo/N-channel linked: one detector
+  fed by the channels combined per linkMode, one gain applied to every channel. The sidechain may be an
+  N-channel bus, linked the same way.
 
 Control I/F:
 - Use DynamicsProcessorParameters structure to get/set object params.
@@ -2102,7 +2961,7 @@ Control I/F:
 class DynamicsProcessor : public IAudioSignalProcessor
 {
 public:
-	DynamicsProcessor() {}	/* C-TOR */
+	DynamicsProcessor() { updateGainTable(); }	/* C-TOR */
 	~DynamicsProcessor() {}	/* D-TOR */
 
 public:
@@ -2115,11 +2974,36 @@ public:
 		detectorParams.clampToUnityMax = false;
 		detectorParams.detect_dB = true;
 		detector.setParameters(detectorParams);
+
+		// --- lookahead delay lines (one per channel), power of 2 for wrapping
+		//     do NOT call from realtime audio thread; this allocates when the sample rate grows
+		sampleRate = _sampleRate;
+		unsigned int maxDelay = (unsigned int)(DYNAMICS_MAX_LOOKAHEAD_MSEC * sampleRate / 1000.0) + 1;
+		unsigned int length = nextPowerOfTwo(maxDelay + 1);
+
+		lookaheadLength = length;
+		if (lookaheadLength * lookaheadChannels > lookaheadCapacity || !lookaheadBuffer)
+		{
+			lookaheadCapacity = lookaheadLength * lookaheadChannels;
+			lookaheadBuffer.reset(new float[lookaheadCapacity]);
+		}
+		memset(&lookaheadBuffer[0], 0, lookaheadLength * lookaheadChannels * sizeof(float));
+		memset(&lookaheadWriteIndex[0], 0, sizeof(lookaheadWriteIndex));
+		updateLookahead();
+
 		return true;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** return true: this object processes linked frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** number of channels processAudioFrame( ) and the multichannel processAudioBlock( ) will be given;
+	    sizes the lookahead delay lines, so call before reset( ), not from the realtime audio thread */
+	void setMaxChannels(unsigned int numChannels)
+	{
+		numChannels = numChannels < 1 ? 1 : (numChannels > DYNAMICS_MAX_CHANNELS ? DYNAMICS_MAX_CHANNELS : numChannels);
+		lookaheadChannels = numChannels;
+	}
 
 	/** enable sidechaib input */
 	virtual void enableAuxInput(bool enableAuxInput){ parameters.enableSidechain = enableAuxInput; }
@@ -2131,6 +3015,13 @@ public:
 		return sidechainInputSample;
 	}
 
+	/** process an N-channel sidechain frame by saving its linked value for the upcoming processAudioFrame() call */
+	double processAuxInputAudioFrame(const float* sidechainFrame, uint32_t sidechainChannels)
+	{
+		sidechainInputSample = linkFrame(sidechainFrame, sidechainChannels);
+		return sidechainInputSample;
+	}
+
 	/** get parameters: note use of custom structure for passing param data */
 	/**
 	\return DynamicsProcessorParameters custom data structure
@@ -2143,14 +3034,32 @@ public:
 	*/
 	void setParameters(const DynamicsProcessorParameters& _parameters)
 	{
+		// --- only rebuild the gain table when the curve changes
+		bool curveChanged = _parameters.ratio != parameters.ratio ||
+							_parameters.threshold_dB != parameters.threshold_dB ||
+							_parameters.kneeWidth_dB != parameters.kneeWidth_dB ||
+							_parameters.hardLimitGate != parameters.hardLimitGate ||
+							_parameters.softKnee != parameters.softKnee ||
+							_parameters.calculation != parameters.calculation;
+
 		parameters = _parameters;
 
 		AudioDetectorParameters detectorParams = detector.getParameters();
 		detectorParams.attackTime_mSec = parameters.attackTime_mSec;
 		detectorParams.releaseTime_mSec = parameters.releaseTime_mSec;
 		detector.setParameters(detectorParams);
+
+		// --- makeup gain only changes here, not per sample
+		makeupGain = pow(10.0, parameters.outputGain_dB / 20.0);
+
+		if (curveChanged)
+			updateGainTable();
+		updateLookahead();
 	}
 
+	/** latency added by the lookahead delay, for reporting to the host */
+	int getLatencyInSamples() { return (int)lookaheadDelay; }
+
 	/** process audio using feed-forward dynamics processor flowchart */
 	/*
 		1. detect input signal
@@ -2161,7 +3070,7 @@ public:
 	\param xn input
 	\return the processed sample
 	*/
-	virtual double processAudioSample(double xn, int channel, double _sampleRate)
+	virtual float processAudioSample(float xn, int channel, double _sampleRate) // changed to float
 	{
 		// --- detect input
 		double detect_dB = 0.0;
@@ -2175,22 +3084,308 @@ public:
 		// --- compute gain
 		double gr = computeGain(detect_dB);
 
-		// --- makeup gain
-		double makeupGain = pow(10.0, parameters.outputGain_dB / 20.0);
+		// --- do DCA + makeup gain (on the delayed signal when using lookahead); a channel past
+		//     setMaxChannels( ) has no lookahead line, so it gets the gain undelayed
+		if (channel < 0 || channel >= (int)lookaheadChannels)
+			return xn * gr * makeupGain;
+		return readLookahead(xn, channel) * gr * makeupGain;
+	}
+
+	/** process one linked frame: one detector and one gain for all channels */
+	/**
+	\param inputFrame input frame, one sample per channel
+	\param outputFrame output frame
+	\param inputChannels number of input channels
+	\param outputChannels number of output channels; outputs with no input are silent
+	\param channel unused, the frame is processed as a whole
+
+	channels past setMaxChannels( ) have no lookahead line: they get the same gain, undelayed
+	\return true if processed
+	*/
+	virtual bool processAudioFrame(float* inputFrame,
+								   float* outputFrame,
+								   uint32_t inputChannels,
+								   uint32_t outputChannels,
+								   int channel,
+								   double _sampleRate)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
+
+		// --- combine the channels once for the detector
+		float detectInput = parameters.enableSidechain ? (float)sidechainInputSample : linkFrame(inputFrame, inputChannels);
+		double gr = computeGain(detector.processAudioSample(detectInput, 0, _sampleRate));
+		float gain = (float)(gr * makeupGain);
+
+		// --- same gain on every channel keeps the stereo image in place
+		uint32_t channels = inputChannels < outputChannels ? inputChannels : outputChannels;
+		uint32_t delayedChannels = channels < lookaheadChannels ? channels : lookaheadChannels;
+
+		for (uint32_t c = 0; c < delayedChannels; c++)
+			outputFrame[c] = readLookahead(inputFrame[c], c) * gain;
+		for (uint32_t c = delayedChannels; c < channels; c++)
+			outputFrame[c] = inputFrame[c] * gain;
+		for (uint32_t c = channels; c < outputChannels; c++)
+			outputFrame[c] = 0.0f;
+
+		return true;
+	}
+
+	/** process a block with the block engine; input and output may be the same array */
+	/*
+		1. detector block (dB)
+		2. gain computer block in dB from the gain table, plus makeup gain
+		3. one dB-to-linear pass
+		4. lookahead delay and DCA
+	*/
+	/**
+	- NOTES:\n
+	works in sub-blocks of DYNAMICS_BLOCK_SIZE with stack scratch buffers, so there is no allocation.
+	Steps 1 and 3 use the fast log2/pow2 approximations and step 2 interpolates the gain table,
+	so the gain tracks processAudioSample( ) to within about 1e-3 dB.\n
+
+	\param input input samples
+	\param output processed samples
+	\param numSamples number of samples in the block
+	\param sidechain external sidechain samples, used when enableSidechain is set (may be nullptr)
+	*/
+	void processAudioBlock(const float* input, float* output, int numSamples, const float* sidechain = nullptr)
+	{
+		float gain_dB[DYNAMICS_BLOCK_SIZE];
+		const float makeup_dB = (float)parameters.outputGain_dB;
+
+		for (int start = 0; start < numSamples; start += DYNAMICS_BLOCK_SIZE)
+		{
+			const int count = numSamples - start < DYNAMICS_BLOCK_SIZE ? numSamples - start : DYNAMICS_BLOCK_SIZE;
+			const float* in = input + start;
+			float* out = output + start;
+
+			// --- 1) detect, from the sidechain if enabled
+			const float* detectInput = parameters.enableSidechain && sidechain ? sidechain + start : in;
+			detector.processAudioBlock(detectInput, gain_dB, count);
+
+			// --- 2) gain reduction in dB from the table
+			for (int n = 0; n < count; n++)
+				gain_dB[n] = lookupGainReduction_dB(gain_dB[n]);
+
+			// --- store values for user meters (last sample of the block)
+			parameters.gainReduction_dB = gain_dB[count - 1];
+			parameters.gainReduction = dB2Raw(parameters.gainReduction_dB);
+
+			// --- 3) dB to linear, makeup gain included
+			for (int n = 0; n < count; n++)
+				gain_dB[n] = fastdB2Raw(gain_dB[n] + makeup_dB);
+
+			// --- 4) lookahead and DCA; the delay line is always written so changing lookahead_mSec never reads stale audio
+			for (int n = 0; n < count; n++)
+				out[n] = readLookahead(in[n], 0) * gain_dB[n];
+		}
+	}
+
+	/** process a multichannel block in place with linked detection; one detector, one gain curve for every channel */
+	/**
+	- NOTES:\n
+	the channels are combined per linkMode before the detector, so the detector, gain table and
+	dB-to-linear passes run once per sample regardless of the channel count.\n
+
+	\param channelData channel buffers, processed in place
+	\param numChannels number of channels; those past setMaxChannels( ) get the gain without lookahead
+	\param numSamples number of samples in the block
+	\param sidechain N-channel sidechain bus, used when enableSidechain is set (may be nullptr)
+	\param numSidechainChannels number of sidechain channels, linked the same way as the input
+	*/
+	void processAudioBlock(float* const* channelData, int numChannels, int numSamples,
+						   const float* const* sidechain = nullptr, int numSidechainChannels = 0)
+	{
+		float link[DYNAMICS_BLOCK_SIZE];
+		float gain[DYNAMICS_BLOCK_SIZE];
+		const float makeup_dB = (float)parameters.outputGain_dB;
+
+		if (numChannels <= 0)
+			return;
+		const int delayedChannels = numChannels < (int)lookaheadChannels ? numChannels : (int)lookaheadChannels;
+
+		const bool useSidechain = parameters.enableSidechain && sidechain && numSidechainChannels > 0;
+
+		for (int start = 0; start < numSamples; start += DYNAMICS_BLOCK_SIZE)
+		{
+			const int count = numSamples - start < DYNAMICS_BLOCK_SIZE ? numSamples - start : DYNAMICS_BLOCK_SIZE;
 
-		// --- do DCA + makeup gain
-		return xn * gr * makeupGain;
+			// --- 1) link the detector channels, then detect once
+			if (useSidechain)
+				linkBlock(sidechain, numSidechainChannels, start, count, link);
+			else
+				linkBlock(channelData, delayedChannels, start, count, link);
+			detector.processAudioBlock(link, gain, count);
+
+			// --- 2) gain reduction in dB from the table
+			for (int n = 0; n < count; n++)
+				gain[n] = lookupGainReduction_dB(gain[n]);
+
+			// --- store values for user meters (last sample of the block)
+			parameters.gainReduction_dB = gain[count - 1];
+			parameters.gainReduction = dB2Raw(parameters.gainReduction_dB);
+
+			// --- 3) dB to linear, makeup gain included
+			for (int n = 0; n < count; n++)
+				gain[n] = fastdB2Raw(gain[n] + makeup_dB);
+
+			// --- 4) lookahead and DCA, same gain on every channel
+			for (int c = 0; c < delayedChannels; c++)
+			{
+				float* data = channelData[c] + start;
+				for (int n = 0; n < count; n++)
+					data[n] = readLookahead(data[n], c) * gain[n];
+			}
+			for (int c = delayedChannels; c < numChannels; c++)
+			{
+				float* data = channelData[c] + start;
+				for (int n = 0; n < count; n++)
+					data[n] *= gain[n];
+			}
+		}
 	}
 
 protected:
 	DynamicsProcessorParameters parameters; ///< object parameters
 	AudioDetector detector; ///< the sidechain audio detector
 
-	// --- storage for sidechain audio input (mono only)
-	double sidechainInputSample = 0.0; ///< storage for sidechain sample
+	// --- storage for sidechain audio input (mono only)
+	double sidechainInputSample = 0.0; ///< storage for sidechain sample
+
+	double makeupGain = 1.0;	///< linear makeup gain, updated in setParameters( )
+	double sampleRate = 44100.0;
+
+	// --- gain computer table: gain reduction (dB) vs. detected level relative to threshold
+	float gainTable_dB[DYNAMICS_GAIN_TABLE_SIZE];
+	float gainTableScale = (DYNAMICS_GAIN_TABLE_SIZE - 1) / (2.0f * DYNAMICS_GAIN_TABLE_RANGE_dB); ///< table points per dB
+
+	// --- lookahead delay lines, lookaheadLength samples per channel
+	std::unique_ptr<float[]> lookaheadBuffer = nullptr;
+	unsigned int lookaheadLength = 0;
+	unsigned int lookaheadChannels = 2;
+	unsigned int lookaheadCapacity = 0;	///< allocated floats; only grows, so a reset( ) at kMaxSupportedSampleRate reserves for good
+	unsigned int lookaheadWriteIndex[DYNAMICS_MAX_CHANNELS] = { 0 };
+	unsigned int lookaheadDelay = 0;	///< in samples
+
+	/** write the input to a channel's lookahead line and return the delayed sample */
+	inline float readLookahead(float xn, unsigned int channel)
+	{
+		if (!lookaheadBuffer)
+			return xn;
+
+		unsigned int wrapMask = lookaheadLength - 1;
+		float* line = &lookaheadBuffer[channel * lookaheadLength];
+		unsigned int& writeIndex = lookaheadWriteIndex[channel];
+
+		line[writeIndex] = xn;
+		float yn = line[(writeIndex - lookaheadDelay) & wrapMask];
+		writeIndex = (writeIndex + 1) & wrapMask;
+		return yn;
+	}
+
+	/** combine one frame for the detector: loudest channel, or RMS across channels */
+	inline float linkFrame(const float* frame, uint32_t numChannels)
+	{
+		if (numChannels == 0)
+			return 0.0f;
+
+		float link = 0.0f;
+		if (parameters.linkMode == dynamicsLinkMode::kMax)
+		{
+			for (uint32_t c = 0; c < numChannels; c++)
+				link = fmaxf(link, fabsf(frame[c]));
+			return link;
+		}
+
+		for (uint32_t c = 0; c < numChannels; c++)
+			link += frame[c] * frame[c];
+		return sqrtf(link / numChannels);
+	}
+
+	/** combine a sub-block of channels for the detector; loops run over samples so they vectorize */
+	inline void linkBlock(const float* const* channels, int numChannels, int start, int count, float* link)
+	{
+		const bool maxLink = parameters.linkMode == dynamicsLinkMode::kMax;
+
+		for (int n = 0; n < count; n++)
+			link[n] = 0.0f;
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			const float* x = channels[c] + start;
+			if (maxLink)
+			{
+				for (int n = 0; n < count; n++)
+				{
+					float v = fabsf(x[n]);
+					link[n] = link[n] > v ? link[n] : v;
+				}
+			}
+			else
+			{
+				for (int n = 0; n < count; n++)
+					link[n] += x[n] * x[n];
+			}
+		}
+
+		if (!maxLink)
+		{
+			const float scale = 1.0f / (float)numChannels;
+			for (int n = 0; n < count; n++)
+				link[n] = fastSqrt(link[n] * scale);
+		}
+	}
+
+	/** convert lookahead_mSec to samples, bounded by the delay line */
+	void updateLookahead()
+	{
+		double delay = parameters.lookahead_mSec < 0.0 ? 0.0 : parameters.lookahead_mSec;
+		delay = fmin(delay, DYNAMICS_MAX_LOOKAHEAD_MSEC);
+		lookaheadDelay = (unsigned int)(delay * sampleRate / 1000.0);
+		if (lookaheadLength > 0 && lookaheadDelay > lookaheadLength - 1)
+			lookaheadDelay = lookaheadLength - 1;
+	}
+
+	/** fill the gain table from computeOutput_dB( ); points are spaced relative to the threshold
+	    so a hard knee lands exactly on a table point */
+	void updateGainTable()
+	{
+		for (unsigned int i = 0; i < DYNAMICS_GAIN_TABLE_SIZE; i++)
+		{
+			double detect_dB = parameters.threshold_dB - DYNAMICS_GAIN_TABLE_RANGE_dB + i / gainTableScale;
+			double gr_dB = computeOutput_dB(detect_dB) - detect_dB;
+			gainTable_dB[i] = (float)fmax(gr_dB, DYNAMICS_GAIN_TABLE_FLOOR_dB);
+		}
+	}
+
+	/** branch-free table lookup with linear interpolation; levels outside the table are held at the ends */
+	inline float lookupGainReduction_dB(float detect_dB)
+	{
+		float pos = (detect_dB - (float)parameters.threshold_dB + DYNAMICS_GAIN_TABLE_RANGE_dB) * gainTableScale;
+		pos = pos < 0.0f ? 0.0f : (pos > (float)(DYNAMICS_GAIN_TABLE_SIZE - 2) ? (float)(DYNAMICS_GAIN_TABLE_SIZE - 2) : pos);
+
+		int index = (int)pos;
+		float fraction = pos - (float)index;
+		return gainTable_dB[index] + fraction * (gainTable_dB[index + 1] - gainTable_dB[index]);
+	}
+
+	/** compute (and save) the current gain value based on detected input (dB) */
+	inline double computeGain(double detect_dB)
+	{
+		double output_dB = computeOutput_dB(detect_dB);
+
+		// --- convert gain; store values for user meters
+		parameters.gainReduction_dB = output_dB - detect_dB;
+		parameters.gainReduction = pow(10.0, (parameters.gainReduction_dB) / 20.0);
+
+		// --- the current gain coefficient value
+		return parameters.gainReduction;
+	}
 
-	/** compute (and save) the current gain value based on detected input (dB) */
-	inline double computeGain(double detect_dB)
+	/** the static gain curve: output level (dB) for a detected input level (dB) */
+	inline double computeOutput_dB(double detect_dB)
 	{
 		double output_dB = 0.0;
 
@@ -2265,12 +3460,7 @@ protected:
 			}
 		}
 
-		// --- convert gain; store values for user meters
-		parameters.gainReduction_dB = output_dB - detect_dB;
-		parameters.gainReduction = pow(10.0, (parameters.gainReduction_dB) / 20.0);
-
-		// --- the current gain coefficient value
-		return parameters.gainReduction;
+		return output_dB;
 	}
 };
 
@@ -2302,13 +3492,26 @@ public:
 		// --- find nearest power of 2 for buffer, save it as bufferLength
 		bufferLength = _bufferLength;
 
-		// --- create new buffer
-		buffer.reset(new T[bufferLength]);
+		// --- create new buffer; reuses the reserved storage when it fits
+		reserveLinearBuffer(bufferLength);
 
 		// --- flush buffer
 		flushBuffer();
 	}
 
+	/** Reserve storage for buffers up to _maxBufferLength SAMPLES, from _arena if given; later createLinearBuffer( )
+	//	   calls that fit only clear memory. do NOT call from realtime audio thread */
+	void reserveLinearBuffer(unsigned int _maxBufferLength, MemoryArena* _arena = nullptr)
+	{
+		if (_arena)
+			arena = _arena;
+		if (_maxBufferLength <= capacity && buffer)
+			return;
+
+		capacity = _maxBufferLength;
+		buffer.allocate(capacity, arena);
+	}
+
 	/** write a value into the buffer; this overwrites the previous oldest value in the buffer */
 	void writeBuffer(unsigned int index, T input)
 	{
@@ -2328,8 +3531,10 @@ public:
 	}
 
 private:
-	std::unique_ptr<T[]> buffer = nullptr;	///< smart pointer will auto-delete
+	ArenaArray<T> buffer;	///< heap or arena storage
 	unsigned int bufferLength = 1024; ///< buffer length
+	unsigned int capacity = 0; ///< allocated length
+	MemoryArena* arena = nullptr; ///< storage source, if any
 };
 
 
@@ -2362,7 +3567,21 @@ public:
 	void createCircularBuffer(unsigned int _bufferLength)
 	{
 		// --- find nearest power of 2 for buffer, and create
-		createCircularBufferPowerOfTwo((unsigned int)(pow(2, ceil(log(_bufferLength) / log(2)))));
+		createCircularBufferPowerOfTwo(nextPowerOfTwo(_bufferLength));
+	}
+
+	/** Reserve storage for buffers up to _maxBufferLength SAMPLES, from _arena if given; later createCircularBuffer( )
+	//	   calls that fit only clear memory. do NOT call from realtime audio thread */
+	void reserveCircularBuffer(unsigned int _maxBufferLength, MemoryArena* _arena = nullptr)
+	{
+		if (_arena)
+			arena = _arena;
+		unsigned int length = nextPowerOfTwo(_maxBufferLength);
+		if (length <= capacity && buffer)
+			return;
+
+		capacity = length;
+		buffer.allocate(capacity, arena);
 	}
 
 	/** Create a buffer based on a target maximum in SAMPLESwhere the size is
@@ -2378,8 +3597,8 @@ public:
 		// --- save (bufferLength - 1) for use as wrapping mask
 		wrapMask = bufferLength - 1;
 
-		// --- create new buffer
-		buffer.reset(new T[bufferLength]);
+		// --- create new buffer; reuses the reserved storage when it fits
+		reserveCircularBuffer(bufferLength);
 
 		// --- flush buffer
 		flushBuffer();
@@ -2432,13 +3651,41 @@ public:
 
 	/** enable or disable interpolation; usually used for diagnostics or in algorithms that require strict integer samples times */
 	void setInterpolate(bool b) { interpolate = b; }
+
+	/** read several fractional taps in one pass (multi-voice chorus/ensemble); the loop has no
+	    data-dependent branches so the compiler can vectorize the gather across taps */
+	/**
+	\param delaysInFractionalSamples array of tap delays, one per tap
+	\param output array to receive the tap values (linearly interpolated, as readBuffer( ), unless setInterpolate(false))
+	\param numTaps number of taps to read
+	*/
+	void readBufferTaps(const float* delaysInFractionalSamples, T* output, unsigned int numTaps)
+	{
+		// --- no interpolation reads the integer part only, like readBuffer( ); a zero fraction keeps the loop branch free
+		const float fractionScale = interpolate ? 1.0f : 0.0f;
+
+		for (unsigned int i = 0; i < numTaps; i++)
+		{
+			// --- integer and fractional part of the delay
+			int intDelay = (int)delaysInFractionalSamples[i];
+			float fraction = fractionScale * (delaysInFractionalSamples[i] - (float)intDelay);
+
+			// --- read-before-write: the last write location is (writeIndex - 1)
+			T y1 = buffer[((writeIndex - 1) - intDelay) & wrapMask];
+			T y2 = buffer[((writeIndex - 2) - intDelay) & wrapMask]; // one sample OLDER
+
+			output[i] = fraction * y2 + (1.0f - fraction) * y1;
+		}
+	}
 	
 	
 private:
-	std::unique_ptr<T[]> buffer = nullptr;	///< smart pointer will auto-delete
+	ArenaArray<T> buffer;				///< heap or arena storage
 	unsigned int writeIndex = 0;		///> write index
 	unsigned int bufferLength = 1024;	///< must be nearest power of 2
 	unsigned int wrapMask = 1023;		///< must be (bufferLength - 1)
+	unsigned int capacity = 0;			///< allocated length (power of 2)
+	MemoryArena* arena = nullptr;		///< storage source, if any
 	bool interpolate = true;			///< interpolation (default is ON)
 };
 
@@ -2717,6 +3964,9 @@ of GUI controls. See the book reference for more details.
 */
 enum class delayUpdateType { kLeftAndRight, kLeftPlusRatio };
 
+// --- max read taps for AudioDelay::processMultiTapAudioSample( )
+const unsigned int MAX_DELAY_TAPS = 8;
+
 
 /**
 \struct AudioDelayParameters
@@ -2851,7 +4101,7 @@ public:
 		//yn = smooth.process(yn);
 
 		// --- create input for delay buffer
-		float dn = xn + (parameters.feedback_Pct / 100.0) * yn; // changed to float
+		float dn = addDenormalOffset(xn + (parameters.feedback_Pct / 100.0) * yn); // changed to float
 
 		// --- write to delay buffer
 		delayBuffer[channel].writeBuffer(dn);
@@ -2862,6 +4112,41 @@ public:
 		return output;
 	}
 
+	/** process MONO audio delay with several read taps sharing the one delay buffer; the input is
+	    written once and the taps are summed with 1/sqrt(N) scaling to keep the wet level steady */
+	/**
+	\param xn input
+	\param channel channel index (selects the delay buffer)
+	\param tapDelays_mSec array of tap delay times, one per tap
+	\param numTaps number of taps, 1 to MAX_DELAY_TAPS
+	\return the processed sample
+	*/
+	float processMultiTapAudioSample(float xn, int channel, const float* tapDelays_mSec, unsigned int numTaps)
+	{
+		if (numTaps < 1) numTaps = 1;
+		if (numTaps > MAX_DELAY_TAPS) numTaps = MAX_DELAY_TAPS;
+
+		// --- convert to samples, then gather all taps
+		float tapDelays[MAX_DELAY_TAPS];
+		float taps[MAX_DELAY_TAPS];
+		for (unsigned int i = 0; i < numTaps; i++)
+			tapDelays[i] = tapDelays_mSec[i] * samplesPerMSec;
+
+		delayBuffer[channel].readBufferTaps(tapDelays, taps, numTaps);
+
+		float yn = 0.0f;
+		for (unsigned int i = 0; i < numTaps; i++)
+			yn += taps[i];
+		yn *= 1.0f / sqrtf((float)numTaps);
+
+		// --- create input for delay buffer; one write for all taps
+		float dn = addDenormalOffset(xn + (parameters.feedback_Pct / 100.0f) * yn);
+		delayBuffer[channel].writeBuffer(dn);
+
+		// --- form mixture out = dry*xn + wet*yn
+		return dryMix * xn + wetMix * yn;
+	}
+
 	/** return true: this object can also process frames */
 	virtual bool canProcessAudioFrame() { return true; }
 
@@ -2909,7 +4194,7 @@ public:
 		//float ynR = delayBuffer_R.readBuffer(delayInSamples_R);
 
 		// --- create input for delay buffer with LEFT channel info
-		float dnL = xnL + (parameters.feedback_Pct / 100.0) * ynL;
+		float dnL = addDenormalOffset(xnL + (parameters.feedback_Pct / 100.0) * ynL);
 
 		// --- create input for delay buffer with RIGHT channel info
 		//float dnR = xnR + (parameters.feedback_Pct / 100.0) * ynR;
@@ -3020,6 +4305,15 @@ public:
 		delayBuffer[0].createCircularBuffer(bufferLength);
 		delayBuffer[1].createCircularBuffer(bufferLength);
 	}
+
+	/** reserve buffers for the highest sample rate up front so createDelayBuffers( ) and reset( )
+	    only clear memory afterwards; do NOT call from realtime audio thread */
+	void reserveDelayBuffers(double _maxSampleRate, double _bufferLength_mSec, MemoryArena* arena = nullptr)
+	{
+		unsigned int maxBufferLength = (unsigned int)(_bufferLength_mSec*(_maxSampleRate / 1000.0)) + 1;
+		delayBuffer[0].reserveCircularBuffer(maxBufferLength, arena);
+		delayBuffer[1].reserveCircularBuffer(maxBufferLength, arena);
+	}
 protected:
 	//APF interpAPF[2];
 	//CParamSmooth smooth(float 0.5f, float 44100f);
@@ -3147,6 +4441,11 @@ public:
 	/** render a new audio output structure */
 	virtual const SignalGenData renderAudioOutput();
 
+	/** render several bipolar outputs spread evenly in phase (output k is offset by k/numOutputs of a cycle);
+	    the timebase advances once per call, just like renderAudioOutput( ), unless advance is false
+	    (to read a second set at the same instant, e.g. the other channel of a frame) */
+	void renderMultiPhaseOutput(float* outputs, unsigned int numOutputs, float phaseOffset = 0.0f, bool advance = true);
+
 protected:
 	// --- parameters
 	OscillatorParameters lfoParameters; ///< obejcgt parameters
@@ -3376,14 +4675,17 @@ protected:
 \brief
 Use this strongly typed enum to easily set modulated delay algorithm.
 
-- enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+- enum class modDelaylgorithm { kFlanger, kChorus, kVibrato, kEnsemble };
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+enum class modDelaylgorithm { kFlanger, kChorus, kVibrato, kEnsemble };
+
+// --- max number of chorus voices for the kEnsemble algorithm
+const unsigned int MAX_ENSEMBLE_VOICES = MAX_DELAY_TAPS;
 
 
 /**
@@ -3410,6 +4712,7 @@ struct ModulatedDelayParameters
 		lfoRate_Hz = params.lfoRate_Hz;
 		lfoDepth_Pct = params.lfoDepth_Pct;
 		feedback_Pct = params.feedback_Pct;
+		ensembleVoices = params.ensembleVoices;
 		return *this;
 	}
 
@@ -3418,6 +4721,7 @@ struct ModulatedDelayParameters
 	float lfoRate_Hz = 0.0f;	///< mod delay LFO rate in Hz
 	float lfoDepth_Pct = 0.0f;	///< mod delay LFO depth in %
 	float feedback_Pct = 0.0f;	///< feedback in %
+	unsigned int ensembleVoices = 4;	///< number of chorus voices for kEnsemble (1 to MAX_ENSEMBLE_VOICES)
 };
 
 /**
@@ -3425,6 +4729,8 @@ struct ModulatedDelayParameters
 \ingroup FX-Objects
 \brief
 The ModulatedDelay object implements the three basic algorithms: flanger, chorus, vibrato.
+The kEnsemble algorithm is an N-voice chorus: up to MAX_ENSEMBLE_VOICES modulated taps are read from the
+one delay buffer per channel, each driven by the same LFO at an evenly spaced phase offset.
 
 Audio I / O :
 	-Processes mono input to mono OR stereo output.
@@ -3469,6 +4775,10 @@ public:
 	*/
 	virtual float processAudioSample(float xn, int channel, double _sampleRate)
 	{
+		// --- multi-voice chorus has its own path
+		if (parameters.algorithm == modDelaylgorithm::kEnsemble)
+			return processEnsembleSample(xn, channel);
+
 		// --- render LFO
 		SignalGenData lfoOutput = lfo.renderAudioOutput();
 
@@ -3535,6 +4845,60 @@ public:
 		return delay.processAudioSample(xn, channel, _sampleRate);
 	}
 
+	/** process one sample through the N-voice ensemble (kEnsemble) */
+	/**
+	\param xn input
+	\param channel channel index; the right channel voices sit half a voice spacing away for width
+	\return the processed sample
+	*/
+	float processEnsembleSample(float xn, int channel)
+	{
+		unsigned int voices = getEnsembleVoices();
+
+		// --- one LFO render for all voices
+		float lfoValues[MAX_ENSEMBLE_VOICES];
+		lfo.renderMultiPhaseOutput(&lfoValues[0], voices, getEnsemblePhaseOffset(channel, voices));
+
+		return processEnsembleTaps(xn, channel, &lfoValues[0], voices);
+	}
+
+	/** clamped voice count for kEnsemble */
+	unsigned int getEnsembleVoices()
+	{
+		unsigned int voices = parameters.ensembleVoices;
+		if (voices < 1) voices = 1;
+		if (voices > MAX_ENSEMBLE_VOICES) voices = MAX_ENSEMBLE_VOICES;
+		return voices;
+	}
+
+	/** LFO phase offset of a channel's voices: the right channel sits half a voice spacing away */
+	float getEnsemblePhaseOffset(int channel, unsigned int voices) { return channel == 0 ? 0.0f : 0.5f / (float)voices; }
+
+	/** modulate the taps from already rendered voice LFO values and read them */
+	/**
+	\param xn input
+	\param channel channel index
+	\param lfoValues one bipolar LFO value per voice
+	\param voices number of voices
+	eturn the processed sample
+	*/
+	float processEnsembleTaps(float xn, int channel, const float* lfoValues, unsigned int voices)
+	{
+		// --- same delay ranges as kChorus
+		const float minDelay_mSec = 10.0f;
+		const float maxDepth_mSec = 30.0f;
+		float depth = parameters.lfoDepth_Pct / 100.0f;
+		float halfRange = 0.5f * maxDepth_mSec;
+		float midpoint = minDelay_mSec + halfRange;
+
+		// --- bipolar modulation of each tap; depth <= 100% keeps us inside the range
+		float tapDelays_mSec[MAX_ENSEMBLE_VOICES];
+		for (unsigned int i = 0; i < voices; i++)
+			tapDelays_mSec[i] = midpoint + depth * lfoValues[i] * halfRange;
+
+		return delay.processMultiTapAudioSample(xn, channel, &tapDelays_mSec[0], voices);
+	}
+
 	/** return true: this object can process frames */
 	virtual bool canProcessAudioFrame() { return true; }
 
@@ -3550,6 +4914,20 @@ public:
 		if (inputChannels == 0 || outputChannels == 0)
 			return false;
 
+		// --- multi-voice chorus: both channels read the LFO at the same instant, which advances once per frame
+		if (parameters.algorithm == modDelaylgorithm::kEnsemble)
+		{
+			unsigned int voices = getEnsembleVoices();
+			uint32_t frameChannels = outputChannels < 2 ? outputChannels : 2;
+			float lfoValues[2][MAX_ENSEMBLE_VOICES];
+			for (uint32_t i = 0; i < frameChannels; i++)
+				lfo.renderMultiPhaseOutput(&lfoValues[i][0], voices, getEnsemblePhaseOffset((int)i, voices), i == frameChannels - 1);
+
+			for (uint32_t i = 0; i < frameChannels; i++)
+				outputFrame[i] = processEnsembleTaps(inputFrame[i < inputChannels ? i : 0], (int)i, &lfoValues[i][0], voices);
+			return true;
+		}
+
 		//setParameters(parameters);
 
 		// --- render LFO
@@ -3641,6 +5019,13 @@ public:
 
 		AudioDelayParameters adParams = delay.getParameters();
 		adParams.feedback_Pct = parameters.feedback_Pct;
+		if (parameters.algorithm == modDelaylgorithm::kEnsemble)
+		{
+			// --- chorus mix, no feedback; set here since the ensemble path does not touch the delay params
+			adParams.wetLevel_dB = -3.0;
+			adParams.dryLevel_dB = -0.0;
+			adParams.feedback_Pct = 0.0;
+		}
 		delay.setParameters(adParams,channel);
 	}
 
@@ -4526,14 +5911,14 @@ public:
 
 		// form w(n) = x(n) + gw(n-D)
 		//double wn = xn + apf_g*wnD;
-		float wn = xn + apf_g*wnD; // changed to float
+		float wn = addDenormalOffset(xn + apf_g*wnD); // changed to float
 
 		// form y(n) = -gw(n) + w(n-D)
 		//double yn = -apf_g * wn + wnD;
 		float yn = -apf_g*wn + wnD; // changed to float
 
 		// underflow check
-		checkFloatUnderflow(yn);
+		denormalGuard(yn);
 
 		// write delay line
 		delay.writeDelay(wn);
@@ -4727,7 +6112,7 @@ public:
 
 		// --- form w(n) = x(n) + gw(n-D)
 		//double wn = xn + apf_g * wnD;
-		float wn = xn + apf_g*wnD; // changed to float
+		float wn = addDenormalOffset(xn + apf_g*wnD); // changed to float
 
 		// --- process wn through inner APF
 		//double ynInner = nestedAPF.processAudioSample(wn);
@@ -4738,7 +6123,7 @@ public:
 		float yn = -apf_g*wn + wnD; // changed to float
 
 		// --- underflow check
-		checkFloatUnderflow(yn);
+		denormalGuard(yn);
 
 		// --- write delay line
 		delay.writeDelay(ynInner);
@@ -5284,7 +6669,7 @@ public:
 	~PeakLimiter() {}
 
 	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	virtual bool reset(double _sampleRate, int channel)
 	{
 		// --- init; true = analog time-constant
 		detector.setSampleRate(_sampleRate);
@@ -5308,58 +6693,422 @@ public:
 	\param xn input
 	\return the processed sample
 	*/
-	virtual double processAudioSample(double xn, int channel, double _sampleRate)
+	virtual float processAudioSample(float xn, int channel, double _sampleRate) // changed to float
+	{
+		return makeUpGain*xn*computeGain(detector.processAudioSample(xn, channel, _sampleRate));
+	}
+
+	/** compute the gain reductino value based on detected value in dB */
+	double computeGain(double detect_dB)
+	{
+		double output_dB = 0.0;
+
+		// --- defaults - you can change these here
+		bool softknee = true;
+		double kneeWidth_dB = 10.0;
+
+		// --- hard knee
+		if (!softknee)
+		{
+			// --- below threshold, unity
+			if (detect_dB <= threshold_dB)
+				output_dB = detect_dB;
+			// --- above threshold, compress
+			else
+				output_dB = threshold_dB;
+		}
+		else
+		{
+			// --- calc gain with knee
+			// --- left side of knee, outside of width, unity gain zone
+			if (2.0*(detect_dB - threshold_dB) < -kneeWidth_dB)
+				output_dB = detect_dB;
+			// --- inside the knee,
+			else if (2.0*(fabs(detect_dB - threshold_dB)) <= kneeWidth_dB)
+				output_dB = detect_dB - pow((detect_dB - threshold_dB + (kneeWidth_dB / 2.0)), 2.0) / (2.0*kneeWidth_dB);
+			// --- right of knee, compression zone
+			else if (2.0*(detect_dB - threshold_dB) > kneeWidth_dB)
+				output_dB = threshold_dB;
+		}
+
+		// --- convert difference between threshold and detected to raw
+		return  pow(10.0, (output_dB - detect_dB) / 20.0);
+	}
+
+	/** adjust threshold in dB */
+	void setThreshold_dB(double _threshold_dB) { threshold_dB = _threshold_dB; }
+
+	/** adjust makeup gain in dB*/
+	void setMakeUpGain_dB(double _makeUpGain_dB) { makeUpGain_dB = _makeUpGain_dB; makeUpGain = dB2Raw(makeUpGain_dB); }
+
+protected:
+	AudioDetector detector;		///< the detector object
+	double threshold_dB = 0.0;	///< stored threshold (dB)
+	double makeUpGain_dB = 0.0;	///< stored makeup gain (dB)
+	double makeUpGain = 1.0;	///< makeup gain (not in dB), only recalculated when it changes
+};
+
+// --- constants for TruePeakLimiter
+const unsigned int TRUEPEAK_OVERSAMPLING = 4;			///< inter-sample phases checked per sample (phase 0 is the sample itself)
+const unsigned int TRUEPEAK_TAPS = 12;					///< taps per interpolation phase
+const unsigned int TRUEPEAK_FILTER_DELAY = 6;			///< samples of delay through the interpolator
+const double TRUEPEAK_MAX_LOOKAHEAD_MSEC = 10.0;		///< largest lookahead (sets the buffer sizes)
+const unsigned int TRUEPEAK_MAX_CHANNELS = 8;			///< max channels linked by processAudioBlock( )
+const int TRUEPEAK_BLOCK_SIZE = 64;						///< sub-block size (stack scratch buffers)
+
+/**
+\struct TruePeakLimiterParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the TruePeakLimiter object.
+*/
+struct TruePeakLimiterParameters
+{
+	TruePeakLimiterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	TruePeakLimiterParameters& operator=(const TruePeakLimiterParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		ceiling_dB = params.ceiling_dB;
+		lookahead_mSec = params.lookahead_mSec;
+		release_mSec = params.release_mSec;
+		enableTruePeak = params.enableTruePeak;
+
+		// --- outputs
+		gainReduction_dB = params.gainReduction_dB;
+
+		return *this;
+	}
+
+	// --- individual parameters
+	double ceiling_dB = -1.0;		///< true peak ceiling (dBTP)
+	double lookahead_mSec = 1.5;	///< lookahead (and attack) time; changes take effect on reset( )
+	double release_mSec = 60.0;		///< release time
+	bool enableTruePeak = true;		///< 4x inter-sample peak detection; false = sample peaks only
+
+	// --- outputs
+	double gainReduction_dB = 0.0;	///< output value: deepest gain reduction in the last block (dB)
+};
+
+/**
+\class TruePeakLimiter
+\ingroup FX-Objects
+\brief
+The TruePeakLimiter object implements a lookahead brickwall limiter for an output stage.
+
+- detection: each sample plus three inter-sample points from a 4x polyphase windowed sinc interpolator
+(true peak estimate, 12 taps per phase as in ITU-R BS.1770), linked across channels
+- the required gain ceiling/peak goes through a sliding window minimum over the lookahead (monotonic deque,
+O(1) amortized per sample), a one-pole release, and a moving average over the same window; since every
+value averaged already holds the upcoming peak's gain, the gain is fully down when the peak leaves the
+delay line, with a smooth (linear in gain) attack
+- the delayed output is also clamped to the ceiling, so sample peaks can never exceed it
+- latency is lookahead - 1 + TRUEPEAK_FILTER_DELAY samples, see getLatencyInSamples( )
+
+Audio I/O:
+- Processes N-channel (linked) blocks with processAudioBlock( ); processAudioSample( ) is for mono use.
+
+Control I/F:
+- Use TruePeakLimiterParameters structure to get/set object params.
+- call setMaxChannels( ) before reset( ); reset( ) allocates (NOT realtime safe) unless reserve( ) was called
+for a sample rate at least as high
+*/
+class TruePeakLimiter : public IAudioSignalProcessor
+{
+public:
+	TruePeakLimiter() {
+		designInterpolator();
+	}		/* C-TOR */
+	~TruePeakLimiter() {}		/* D-TOR */
+
+	/** number of channels processAudioBlock( ) will be given; takes effect on the next reset( ) */
+	void setMaxChannels(unsigned int numChannels)
+	{
+		maxChannels = numChannels < 1 ? 1 : (numChannels > TRUEPEAK_MAX_CHANNELS ? TRUEPEAK_MAX_CHANNELS : numChannels);
+	}
+
+	/** allocate for the longest lookahead at _maxSampleRate and the current channel count, from _arena if
+	    given, so reset( ) at or below that rate only clears memory; NOT realtime safe */
+	void reserve(double _maxSampleRate, MemoryArena* _arena = nullptr)
+	{
+		if (_arena)
+			arena = _arena;
+
+		unsigned int maxWindow = (unsigned int)(TRUEPEAK_MAX_LOOKAHEAD_MSEC * 0.001 * _maxSampleRate + 0.5);
+		maxWindow = maxWindow < 1 ? 1 : maxWindow;
+
+		// --- same sizes reset( ) derives from the window, at the longest window
+		unsigned int maxDelayLength = nextPowerOfTwo(maxWindow + TRUEPEAK_FILTER_DELAY);
+		unsigned int maxDequeLength = nextPowerOfTwo(maxWindow + 1);
+
+		if (maxDelayLength * maxChannels > delayCapacity)
+		{
+			delayCapacity = maxDelayLength * maxChannels;
+			delayLine.allocate(delayCapacity, arena);
+		}
+		if (maxDequeLength > dequeCapacity)
+		{
+			dequeCapacity = maxDequeLength;
+			dequeValue.allocate(dequeCapacity, arena);
+			dequeTime.allocate(dequeCapacity, arena);
+		}
+		if (maxWindow > boxCapacity)
+		{
+			boxCapacity = maxWindow;
+			boxBuffer.allocate(boxCapacity, arena);
+		}
+	}
+
+	/** size the delay lines and window for the lookahead and clear all state */
+	virtual bool reset(double _sampleRate, int channel)
+	{
+		sampleRate = _sampleRate;
+		reserve(sampleRate);
+
+		window = (unsigned int)(parameters.lookahead_mSec * 0.001 * sampleRate + 0.5);
+		unsigned int maxWindow = (unsigned int)(TRUEPEAK_MAX_LOOKAHEAD_MSEC * 0.001 * sampleRate + 0.5);
+		window = window < 1 ? 1 : (window > maxWindow ? maxWindow : window);
+		delay = window - 1 + TRUEPEAK_FILTER_DELAY;
+
+		// --- delay lines: power of two, one per channel
+		delayLength = nextPowerOfTwo(delay + 1);
+		memset(&delayLine[0], 0, delayLength * maxChannels * sizeof(float));
+		writeIndex = 0;
+
+		// --- deque holds at most window + 1 entries
+		dequeLength = nextPowerOfTwo(window + 1);
+		dequeHead = 0;
+		dequeTail = 0;
+		sampleCount = 0;
+
+		// --- moving average starts at unity gain
+		for (unsigned int i = 0; i < window; i++)
+			boxBuffer[i] = 1.0f;
+		boxSum = window;
+		boxIndex = 0;
+
+		releaseGain = 1.0f;
+		memset(history, 0, sizeof(history));
+
+		updateCoefficients();
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return TruePeakLimiterParameters custom data structure
+	*/
+	TruePeakLimiterParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param TruePeakLimiterParameters custom data structure
+	*/
+	void setParameters(const TruePeakLimiterParameters& params)
+	{
+		parameters = params;
+		updateCoefficients();
+	}
+
+	/** samples of delay through the limiter */
+	int getLatencyInSamples() { return (int)delay; }
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process one mono sample (a block of one on channel 0) */
+	virtual float processAudioSample(float xn, int channel, double _sampleRate)
+	{
+		float* data[1] = { &xn };
+		processAudioBlock(data, 1, 1);
+		return xn;
+	}
+
+	/** limit an N-channel block in place; every channel gets the same (linked) gain */
+	/**
+	\param channelData N pointers to the channel buffers
+	\param numChannels number of channels (up to setMaxChannels( ))
+	\param numSamples number of samples in the block
+	*/
+	void processAudioBlock(float* const* channelData, int numChannels, int numSamples)
+	{
+		if (!delayLine)
+			return;
+		numChannels = numChannels > (int)maxChannels ? (int)maxChannels : numChannels;
+
+		float peak[TRUEPEAK_BLOCK_SIZE];
+		float gain[TRUEPEAK_BLOCK_SIZE];
+		float minGain = 1.0f;
+
+		for (int start = 0; start < numSamples; start += TRUEPEAK_BLOCK_SIZE)
+		{
+			const int count = numSamples - start < TRUEPEAK_BLOCK_SIZE ? numSamples - start : TRUEPEAK_BLOCK_SIZE;
+
+			// --- linked true peak detection
+			for (int n = 0; n < count; n++)
+				peak[n] = 0.0f;
+			for (int c = 0; c < numChannels; c++)
+				detectPeaks(channelData[c] + start, c, peak, count);
+
+			// --- gain computer: sliding minimum, release, moving average
+			computeGain(peak, gain, count);
+
+			// --- delayed audio times gain, clamped to the ceiling
+			for (int c = 0; c < numChannels; c++)
+			{
+				float* data = channelData[c] + start;
+				float* line = &delayLine[c * delayLength];
+				unsigned int w = writeIndex;
+				for (int n = 0; n < count; n++)
+				{
+					line[w & (delayLength - 1)] = data[n];
+					float y = line[(w - delay) & (delayLength - 1)] * gain[n];
+					y = y > ceiling ? ceiling : y;
+					data[n] = y < -ceiling ? -ceiling : y;
+					w++;
+				}
+			}
+			writeIndex += count;
+
+			for (int n = 0; n < count; n++)
+				minGain = gain[n] < minGain ? gain[n] : minGain;
+		}
+
+		parameters.gainReduction_dB = fastRaw2dB(minGain);
+	}
+
+protected:
+	/** 4x interpolator phases 1..3: Kaiser windowed sinc, each phase normalized to unity DC gain */
+	void designInterpolator()
 	{
-		return dB2Raw(makeUpGain_dB)*xn*computeGain(detector.processAudioSample(xn, channel, _sampleRate));
+		for (unsigned int p = 1; p < TRUEPEAK_OVERSAMPLING; p++)
+		{
+			double sum = 0.0;
+			for (unsigned int k = 0; k < TRUEPEAK_TAPS; k++)
+			{
+				// --- tap k reads x[n - k]; the phase sits p/4 of a sample after x[n - TRUEPEAK_FILTER_DELAY]
+				double t = (double)k - TRUEPEAK_FILTER_DELAY + (double)p / TRUEPEAK_OVERSAMPLING;
+				double sinc = sin(kPi * t) / (kPi * t);
+				double w = t / (0.5 * TRUEPEAK_TAPS + 0.5);
+				double window = 0.42 + 0.5 * cos(kPi * w) + 0.08 * cos(2.0 * kPi * w); // Blackman
+				phaseTaps[p - 1][k] = (float)(sinc * window);
+				sum += sinc * window;
+			}
+			for (unsigned int k = 0; k < TRUEPEAK_TAPS; k++)
+				phaseTaps[p - 1][k] = (float)(phaseTaps[p - 1][k] / sum);
+		}
+	}
+
+	/** ceiling, release coefficient */
+	void updateCoefficients()
+	{
+		ceiling = (float)pow(10.0, parameters.ceiling_dB / 20.0);
+		releaseCoeff = (float)exp(-1.0 / (parameters.release_mSec * 0.001 * sampleRate));
+	}
+
+	/** peak[n] = max(peak[n], |x| at the sample and its inter-sample points), aligned TRUEPEAK_FILTER_DELAY late */
+	void detectPeaks(const float* input, int channel, float* peak, int count)
+	{
+		const int historyLength = TRUEPEAK_TAPS - 1;
+		float work[TRUEPEAK_TAPS - 1 + TRUEPEAK_BLOCK_SIZE];
+		memcpy(work, history[channel], historyLength * sizeof(float));
+		memcpy(work + historyLength, input, count * sizeof(float));
+
+		const bool truePeak = parameters.enableTruePeak;
+		for (int n = 0; n < count; n++)
+		{
+			const float* x = work + historyLength + n;
+			float sample = x[-(int)TRUEPEAK_FILTER_DELAY];
+			float p = sample < 0.0f ? -sample : sample;
+
+			if (truePeak)
+			{
+				for (unsigned int phase = 0; phase < TRUEPEAK_OVERSAMPLING - 1; phase++)
+				{
+					float sum = 0.0f;
+					for (unsigned int k = 0; k < TRUEPEAK_TAPS; k++)
+						sum += phaseTaps[phase][k] * x[-(int)k];
+					sum = sum < 0.0f ? -sum : sum;
+					p = sum > p ? sum : p;
+				}
+			}
+			peak[n] = p > peak[n] ? p : peak[n];
+		}
+
+		memcpy(history[channel], work + count, historyLength * sizeof(float));
 	}
 
-	/** compute the gain reductino value based on detected value in dB */
-	double computeGain(double detect_dB)
+	/** required gain -> sliding minimum over the window -> release -> moving average over the window */
+	void computeGain(const float* peak, float* gain, int count)
 	{
-		double output_dB = 0.0;
-
-		// --- defaults - you can change these here
-		bool softknee = true;
-		double kneeWidth_dB = 10.0;
+		const unsigned int mask = dequeLength - 1;
+		const double inverseWindow = 1.0 / window;
 
-		// --- hard knee
-		if (!softknee)
-		{
-			// --- below threshold, unity
-			if (detect_dB <= threshold_dB)
-				output_dB = detect_dB;
-			// --- above threshold, compress
-			else
-				output_dB = threshold_dB;
-		}
-		else
+		for (int n = 0; n < count; n++)
 		{
-			// --- calc gain with knee
-			// --- left side of knee, outside of width, unity gain zone
-			if (2.0*(detect_dB - threshold_dB) < -kneeWidth_dB)
-				output_dB = detect_dB;
-			// --- inside the knee,
-			else if (2.0*(fabs(detect_dB - threshold_dB)) <= kneeWidth_dB)
-				output_dB = detect_dB - pow((detect_dB - threshold_dB + (kneeWidth_dB / 2.0)), 2.0) / (2.0*kneeWidth_dB);
-			// --- right of knee, compression zone
-			else if (2.0*(detect_dB - threshold_dB) > kneeWidth_dB)
-				output_dB = threshold_dB;
-		}
+			float required = ceiling / (peak[n] > ceiling ? peak[n] : ceiling);
 
-		// --- convert difference between threshold and detected to raw
-		return  pow(10.0, (output_dB - detect_dB) / 20.0);
-	}
+			// --- monotonic deque: drop entries that can no longer be the minimum, then expired ones
+			while (dequeTail != dequeHead && dequeValue[(dequeTail - 1) & mask] >= required)
+				dequeTail--;
+			dequeValue[dequeTail & mask] = required;
+			dequeTime[dequeTail & mask] = sampleCount;
+			dequeTail++;
+			if (sampleCount - dequeTime[dequeHead & mask] >= window)
+				dequeHead++;
+			sampleCount++;
 
-	/** adjust threshold in dB */
-	void setThreshold_dB(double _threshold_dB) { threshold_dB = _threshold_dB; }
+			float held = dequeValue[dequeHead & mask];
 
-	/** adjust makeup gain in dB*/
-	void setMakeUpGain_dB(double _makeUpGain_dB) { makeUpGain_dB = _makeUpGain_dB; }
+			// --- instant down, release up (never above the held value)
+			releaseGain = held < releaseGain ? held : held + releaseCoeff * (releaseGain - held);
 
-protected:
-	AudioDetector detector;		///< the detector object
-	double threshold_dB = 0.0;	///< stored threshold (dB)
-	double makeUpGain_dB = 0.0;	///< stored makeup gain (dB)
+			// --- moving average; double sum so it does not drift
+			boxSum += (double)releaseGain - (double)boxBuffer[boxIndex];
+			boxBuffer[boxIndex] = releaseGain;
+			boxIndex = boxIndex + 1 < window ? boxIndex + 1 : 0;
+
+			gain[n] = (float)(boxSum * inverseWindow);
+		}
+	}
+
+	TruePeakLimiterParameters parameters;	///< object parameters
+	double sampleRate = 44100.0;			///< current sample rate
+	unsigned int maxChannels = 2;			///< channels allocated in reset( )
+	unsigned int delayCapacity = 0;			///< allocated sizes; these only grow (see reserve( ))
+	unsigned int dequeCapacity = 0;
+	unsigned int boxCapacity = 0;
+	MemoryArena* arena = nullptr;			///< storage source, if any
+
+	float ceiling = 1.0f;					///< ceiling (not in dB)
+	float releaseCoeff = 0.0f;				///< one-pole release coefficient
+
+	// --- true peak interpolator
+	float phaseTaps[TRUEPEAK_OVERSAMPLING - 1][TRUEPEAK_TAPS] = { { 0.0f } };	///< phases 1..3
+	float history[TRUEPEAK_MAX_CHANNELS][TRUEPEAK_TAPS - 1] = { { 0.0f } };		///< last inputs per channel
+
+	// --- lookahead delay lines, [channel][delayLength]
+	ArenaArray<float> delayLine;
+	unsigned int delayLength = 0;
+	unsigned int writeIndex = 0;
+	unsigned int delay = 0;					///< latency in samples
+	unsigned int window = 1;				///< lookahead in samples
+
+	// --- sliding minimum (monotonic deque on a power of two ring)
+	ArenaArray<float> dequeValue;
+	ArenaArray<uint32_t> dequeTime;
+	unsigned int dequeLength = 0;
+	unsigned int dequeHead = 0;
+	unsigned int dequeTail = 0;
+	uint32_t sampleCount = 0;
+
+	// --- release and moving average
+	float releaseGain = 1.0f;
+	ArenaArray<float> boxBuffer;
+	double boxSum = 0.0;
+	unsigned int boxIndex = 0;
 };
 
 
@@ -5380,6 +7129,9 @@ enum class vaFilterAlgorithm {
 	kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS
 }; // --- you will add more here...
 
+// --- channels processed together by ZVAFilter::processAudioBlock( )
+const unsigned int ZVA_MAX_CHANNELS = 2;
+
 
 /**
 \struct ZVAFilterParameters
@@ -5431,6 +7183,7 @@ struct ZVAFilterParameters
 The ZVAFilter object implements multpile Zavalishin VA Filters.
 Audio I/O:
 - Processes mono input to mono output.
+- processAudioBlock( ) processes mono or stereo blocks, optionally with a per-sample fc modulation buffer.
 
 Control I/F:
 - Use BiquadParameters structure to get/set object params.
@@ -5452,6 +7205,10 @@ public:
 		sampleRate = _sampleRate;
 		integrator_z[0] = 0.0;
 		integrator_z[1] = 0.0;
+		memset(&block_z[0][0], 0, sizeof(block_z));
+
+		// --- coefficients depend on the sample rate
+		calculateFilterCoeffs();
 
 		return true;
 	}
@@ -5591,6 +7348,123 @@ public:
 		return filterOutputGain*lpf;
 	}
 
+	/** process a mono or stereo block in place, optionally sweeping fc per sample */
+	/**
+	- NOTES:\n
+	with fcModulation the prewarped coefficients are recomputed every sample with fastTan( ) (no tan( ) call),
+	once per sample for all channels; without it the coefficients from setParameters( ) are used as is.
+	The algorithm choice is resolved into output weights before the loop, and the integrator state is
+	stored block_z[integrator][channel] so the channel loop works on adjacent registers (one SIMD pair
+	for stereo). The block path has its own state; don't mix it with processAudioSample( ) on one object.\n
+
+	\param channelData channel buffers, processed in place
+	\param numChannels 1 or 2 (up to ZVA_MAX_CHANNELS)
+	\param numSamples number of samples in the block
+	\param fcModulation fc in Hz for each sample (e.g. a rendered LFO sweep), or nullptr for the static fc
+	*/
+	void processAudioBlock(float* const* channelData, int numChannels, int numSamples, const float* fcModulation = nullptr)
+	{
+		if (numChannels > (int)ZVA_MAX_CHANNELS)
+			numChannels = (int)ZVA_MAX_CHANNELS;
+		if (numChannels <= 0)
+			return;
+
+		const vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
+		const bool matchAnalogNyquistLPF = zvaFilterParameters.matchAnalogNyquistLPF;
+
+		// --- gain compensation and output gain only depend on parameters, once per block
+		float inputGain = 1.0f;
+		if (zvaFilterParameters.enableGainComp)
+		{
+			double peak_dB = dBPeakGainFor_Q(zvaFilterParameters.Q);
+			if (peak_dB > 0.0)
+				inputGain = (float)dB2Raw(-peak_dB / 2.0);
+		}
+
+		// --- fixed coefficients, replaced per sample when modulated
+		float g = (float)alpha;
+		float a1 = (float)alpha;
+		float a0 = (float)alpha0;
+		float p = (float)rho;
+		float sigma = (float)analogMatchSigma;
+
+		const float R = zvaFilterParameters.selfOscillate ? 0.0f : (float)(1.0 / (2.0*zvaFilterParameters.Q));
+		const float piOverFs = (float)(kPi / sampleRate);
+		const float maxFc = (float)(0.49 * sampleRate);
+		const float nyquist = (float)(sampleRate / 2.0);
+
+		// --- 1st order filters: y = wL*lpf + (wH + wHa*alpha)*hpf
+		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kAPF1)
+		{
+			const float wL = filterAlgorithm == vaFilterAlgorithm::kHPF1 ? 0.0f : 1.0f;
+			const float wH = filterAlgorithm == vaFilterAlgorithm::kHPF1 ? 1.0f : (filterAlgorithm == vaFilterAlgorithm::kAPF1 ? -1.0f : 0.0f);
+			const float wHa = filterAlgorithm == vaFilterAlgorithm::kLPF1 && matchAnalogNyquistLPF ? 1.0f : 0.0f;
+
+			for (int n = 0; n < numSamples; n++)
+			{
+				if (fcModulation)
+				{
+					float fc = fcModulation[n] > maxFc ? maxFc : fcModulation[n];
+					float gn = fastTan(piOverFs * fc);
+					a1 = gn / (1.0f + gn);
+				}
+
+				for (int c = 0; c < numChannels; c++)
+				{
+					float xn = addDenormalOffset(channelData[c][n] * inputGain);
+					float vn = (xn - block_z[0][c])*a1;
+					float lpf = vn + block_z[0][c];
+					block_z[0][c] = vn + lpf;
+					float hpf = xn - lpf;
+					channelData[c][n] = wL*lpf + (wH + wHa*a1)*hpf;
+				}
+			}
+			return;
+		}
+
+		// --- state variable filters: y = gain*(wL*lpf + wH*hpf + wB*bpf + wS*sigma*sn)
+		const float filterOutputGain = (float)pow(10.0, zvaFilterParameters.filterOutputGain_dB / 20.0);
+		const float wL = filterAlgorithm == vaFilterAlgorithm::kSVF_HP || filterAlgorithm == vaFilterAlgorithm::kSVF_BP ? 0.0f : 1.0f;
+		const float wH = filterAlgorithm == vaFilterAlgorithm::kSVF_HP || filterAlgorithm == vaFilterAlgorithm::kSVF_BS ? 1.0f : 0.0f;
+		const float wB = filterAlgorithm == vaFilterAlgorithm::kSVF_BP ? 1.0f : 0.0f;
+		const float wS = filterAlgorithm == vaFilterAlgorithm::kSVF_LP && matchAnalogNyquistLPF ? 1.0f : 0.0f;
+		const bool enableNLP = zvaFilterParameters.enableNLP;
+
+		for (int n = 0; n < numSamples; n++)
+		{
+			if (fcModulation)
+			{
+				float fc = fcModulation[n] < 1.0f ? 1.0f : (fcModulation[n] > maxFc ? maxFc : fcModulation[n]);
+				g = fastTan(piOverFs * fc);
+				a0 = 1.0f / (1.0f + 2.0f*R*g + g*g);
+				p = 2.0f*R + g;
+
+				float f_o = nyquist / fc;
+				sigma = 1.0f / (g*f_o*f_o);
+			}
+
+			for (int c = 0; c < numChannels; c++)
+			{
+				float xn = addDenormalOffset(channelData[c][n] * inputGain);
+				float hpf = a0*(xn - p*block_z[0][c] - block_z[1][c]);
+
+				float bpf = g*hpf + block_z[0][c];
+				if (enableNLP)
+					bpf = (float)softClipWaveShaper(bpf, 1.0);
+
+				float lpf = g*bpf + block_z[1][c];
+				float sn = block_z[0][c];
+
+				block_z[0][c] = g*hpf + bpf;
+				block_z[1][c] = g*bpf + lpf;
+
+				channelData[c][n] = filterOutputGain*(wL*lpf + wH*hpf + wB*bpf + wS*sigma*sn);
+			}
+		}
+	}
+
 	/** recalculate the filter coefficients*/
 	void calculateFilterCoeffs()
 	{
@@ -5639,6 +7513,7 @@ protected:
 
 	// --- state storage
 	double integrator_z[2];						///< state variables
+	float block_z[2][ZVA_MAX_CHANNELS] = { { 0.0f } };	///< processAudioBlock( ) state, [integrator][channel]
 
 	// --- filter coefficients
 	double alpha0 = 0.0;		///< input scalar, correct delay-free loop
@@ -5839,6 +7714,213 @@ Use this strongly typed enum to easily set the waveshaper model for the Triode o
 */
 enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
 
+/**
+\enum waveshaperMode
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to set how the Triode objects evaluate the waveshaper.
+
+- enum class waveshaperMode { kDirect, kTable, kTableADAA };
+- kDirect: call the waveshaper function every sample (exp/atan in double)
+- kTable: interpolated lookup table, rebuilt only when the curve changes
+- kTableADAA: lookup table with first order antiderivative anti-aliasing
+*/
+enum class waveshaperMode { kDirect, kTable, kTableADAA };
+
+// --- constants for WaveShaperTable
+const unsigned int WAVESHAPER_TABLE_POINTS = 2049;		///< table points across the input range
+const double WAVESHAPER_TABLE_RANGE = 4.0;				///< table spans at most +/- this input; beyond it the curve is evaluated directly
+const double WAVESHAPER_SATURATED_ARGUMENT = 24.0;		///< exp( ) curves are flat (e^-24) past this argument, so the table can stop there
+const double WAVESHAPER_MIN_SATURATION = 1.0e-9;		///< below this gain the closed form antiderivatives are replaced by their limits
+const double WAVESHAPER_ADAA_EPSILON = 1.0e-5;			///< ADAA falls back to the midpoint below this input step
+
+/**
+\class WaveShaperTable
+\ingroup FX-Objects
+\brief
+The WaveShaperTable object stores one of the distortionModel curves as a lookup table with linear
+interpolation, and the exact antiderivative of that interpolated curve for ADAA.
+
+- the table is built from the same waveshaper functions the Triode objects call directly
+- for the exp( ) curves the range shrinks with the saturation gain to where the steeper side is flat, so
+the points stay dense where the curve bends
+- outside the table the curve is evaluated directly and its antiderivative in closed form, so large
+inputs follow the real curve instead of being clamped (atan keeps rising past any range)
+- ADAA output is (F1(x[n]) - F1(x[n-1]))/(x[n] - x[n-1]), which suppresses aliasing at the cost of a
+half sample delay; F1 is stored in double so the difference does not lose precision
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- call build( ) with the curve parameters; only when they change (NOT realtime safe)
+*/
+class WaveShaperTable
+{
+public:
+	WaveShaperTable() {
+		shape.reset(new float[WAVESHAPER_TABLE_POINTS]);
+		antiderivative.reset(new double[WAVESHAPER_TABLE_POINTS]);
+		build(distortionModel::kSoftClip, 1.0, 0.0);
+	}		/* C-TOR */
+	~WaveShaperTable() {}		/* D-TOR */
+
+	/** fill the table for a curve; the ADAA history is cleared */
+	void build(distortionModel model, double saturation, double asymmetry)
+	{
+		shapeModel = model;
+		shapeSaturation = saturation;
+		shapeAsymmetry = asymmetry;
+
+		// --- sized for the steeper side; a softer side still bending past the edge is evaluated directly
+		double range = WAVESHAPER_TABLE_RANGE;
+		if (model != distortionModel::kArcTan)
+		{
+			double maxGain = fabs(saturation) * (1.0 + 4.0*fabs(asymmetry));
+			if (maxGain * range > WAVESHAPER_SATURATED_ARGUMENT)
+				range = WAVESHAPER_SATURATED_ARGUMENT / maxGain;
+		}
+		minInput = -range;
+		maxInput = range;
+		step = 2.0 * range / (WAVESHAPER_TABLE_POINTS - 1);
+		scale = 1.0 / step;
+
+		for (unsigned int i = 0; i < WAVESHAPER_TABLE_POINTS; i++)
+		{
+			double x = minInput + i * step;
+			double y = 0.0;
+			if (model == distortionModel::kSoftClip)
+				y = softClipWaveShaper(x, saturation);
+			else if (model == distortionModel::kArcTan)
+				y = atanWaveShaper(x, saturation);
+			else if (model == distortionModel::kFuzzAsym)
+				y = fuzzExp1WaveShaper(x, saturation, asymmetry);
+			shape[i] = (float)y;
+		}
+
+		// --- trapezoid integral of the interpolated curve is its exact antiderivative at the points
+		antiderivative[0] = 0.0;
+		for (unsigned int i = 1; i < WAVESHAPER_TABLE_POINTS; i++)
+		{
+			antiderivative[i] = antiderivative[i - 1] + 0.5 * step * ((double)shape[i - 1] + (double)shape[i]);
+		}
+
+		reset();
+	}
+
+	/** clear the ADAA history */
+	void reset()
+	{
+		x1 = 0.0;
+		F1_x1 = getAntiderivative(0.0);
+	}
+
+	/** interpolated waveshaper output; the curve itself outside the table */
+	inline double processAudioSample(double xn)
+	{
+		if (xn < minInput || xn > maxInput)
+			return directShape(xn);
+
+		double position = (xn - minInput) * scale;
+		position = position < 0.0 ? 0.0 : (position > WAVESHAPER_TABLE_POINTS - 1 ? WAVESHAPER_TABLE_POINTS - 1 : position);
+
+		int index = (int)position;
+		index = index > (int)WAVESHAPER_TABLE_POINTS - 2 ? (int)WAVESHAPER_TABLE_POINTS - 2 : index;
+		float fraction = (float)(position - index);
+		return shape[index] + fraction * (shape[index + 1] - shape[index]);
+	}
+
+	/** first order ADAA output; the midpoint of the table handles near-equal inputs */
+	inline double processAudioSampleADAA(double xn)
+	{
+		double F1_xn = getAntiderivative(xn);
+		double delta = xn - x1;
+
+		double output = 0.0;
+		if (fabs(delta) < WAVESHAPER_ADAA_EPSILON)
+			output = processAudioSample(0.5 * (xn + x1));
+		else
+			output = (F1_xn - F1_x1) / delta;
+
+		x1 = xn;
+		F1_x1 = F1_xn;
+		return output;
+	}
+
+protected:
+	/** the curve, as the Triode objects evaluate it directly */
+	inline double directShape(double xn)
+	{
+		if (shapeModel == distortionModel::kSoftClip)
+			return softClipWaveShaper(xn, shapeSaturation);
+		else if (shapeModel == distortionModel::kArcTan)
+			return atanWaveShaper(xn, shapeSaturation);
+		return fuzzExp1WaveShaper(xn, shapeSaturation, shapeAsymmetry);
+	}
+
+	/** closed form antiderivative of the curve (any constant), for the parts outside the table */
+	inline double directAntiderivative(double xn)
+	{
+		if (shapeModel == distortionModel::kArcTan)
+		{
+			// --- integral of atan(kx) is x atan(kx) - ln(1 + (kx)^2) / 2k
+			double k = shapeSaturation;
+			if (fabs(k) < WAVESHAPER_MIN_SATURATION)
+				return 0.5 * xn * xn;
+			return (xn * atan(k * xn) - 0.5 * log1p(k * k * xn * xn) / k) / atan(k);
+		}
+
+		// --- sgn(x)(1 - e^-g|x|) / norm integrates to (|x| + e^-g|x| / g) / norm on either side
+		double g = fabs(shapeSaturation);
+		double norm = 1.0;
+		if (shapeModel == distortionModel::kFuzzAsym)
+		{
+			g = calcWSGain(xn, shapeSaturation, shapeAsymmetry);
+			norm = 1.0 - exp(-g);
+		}
+		if (fabs(g) < WAVESHAPER_MIN_SATURATION)
+			return shapeModel == distortionModel::kFuzzAsym ? 0.5 * xn * xn : 0.0;
+
+		double ax = fabs(xn);
+		return (ax + exp(-g * ax) / g) / norm;
+	}
+
+	/** antiderivative of the interpolated curve inside the table, continued with the curve's own outside it */
+	inline double getAntiderivative(double xn)
+	{
+		if (xn < minInput)
+			return antiderivative[0] + directAntiderivative(xn) - directAntiderivative(minInput);
+		if (xn > maxInput)
+			return antiderivative[WAVESHAPER_TABLE_POINTS - 1] + directAntiderivative(xn) - directAntiderivative(maxInput);
+
+		double position = (xn - minInput) * scale;
+		position = position < 0.0 ? 0.0 : (position > WAVESHAPER_TABLE_POINTS - 1 ? WAVESHAPER_TABLE_POINTS - 1 : position);
+
+		int index = (int)position;
+		index = index > (int)WAVESHAPER_TABLE_POINTS - 2 ? (int)WAVESHAPER_TABLE_POINTS - 2 : index;
+		double fraction = position - index;
+
+		double y0 = shape[index];
+		double y1 = shape[index + 1];
+		return antiderivative[index] + step * fraction * (y0 + 0.5 * fraction * (y1 - y0));
+	}
+
+	std::unique_ptr<float[]> shape;				///< curve at the table points
+	std::unique_ptr<double[]> antiderivative;	///< antiderivative at the table points
+	double minInput = -WAVESHAPER_TABLE_RANGE;	///< input at the first point
+	double maxInput = WAVESHAPER_TABLE_RANGE;	///< input at the last point
+	double step = 0.0;		///< input spacing of the points
+	double scale = 0.0;		///< points per unit input
+
+	double x1 = 0.0;		///< ADAA: last input
+	double F1_x1 = 0.0;		///< ADAA: antiderivative at the last input
+
+	// --- curve the table was built for, evaluated directly outside the table
+	distortionModel shapeModel = distortionModel::kSoftClip;
+	double shapeSaturation = 1.0;
+	double shapeAsymmetry = 0.0;
+};
+
 /**
 \struct TriodeClassAParameters
 \ingroup FX-Objects
@@ -5860,6 +7942,7 @@ struct TriodeClassAParameters
 			return *this;
 
 		waveshaper = params.waveshaper;
+		shaperMode = params.shaperMode;
 		saturation = params.saturation;
 		asymmetry = params.asymmetry;
 		outputGain = params.outputGain;
@@ -5877,6 +7960,7 @@ struct TriodeClassAParameters
 
 	// --- individual parameters
 	distortionModel waveshaper = distortionModel::kSoftClip; ///< waveshaper
+	waveshaperMode shaperMode = waveshaperMode::kDirect; ///< direct, table, or table with ADAA
 
 	double saturation = 1.0;	///< saturation level
 	double asymmetry = 0.0;		///< asymmetry level
@@ -5898,6 +7982,10 @@ struct TriodeClassAParameters
 The TriodeClassA object simulates a triode in class A configuration. This is a very simple and basic simulation
 and a starting point for other designs; it is not intended to be a full-fledged triode simulator.
 
+- shaperMode kTable/kTableADAA run the waveshaper from a WaveShaperTable (kDirect is the default); the
+table is built only in those modes, when switching into them or when the waveshaper, saturation or
+asymmetry change, so setParameters( ) is cheap otherwise
+
 Audio I/O:
 - Processes mono input to mono output.
 
@@ -5930,6 +8018,7 @@ public:
 	{
 		outputHPF.reset(_sampleRate, channel);
 		outputLSF.reset(_sampleRate, channel);
+		shaperTable.reset();
 
 		// ---
 		return true;
@@ -5947,6 +8036,15 @@ public:
 	*/
 	void setParameters(const TriodeClassAParameters& params)
 	{
+		// --- the table is only read in the table modes: rebuild it when the curve changes there, or when
+		//     switching in from kDirect (the curve may have changed while it was unused)
+		bool curveChanged = params.waveshaper != parameters.waveshaper || params.saturation != parameters.saturation ||
+							params.asymmetry != parameters.asymmetry;
+		bool tableMode = params.shaperMode != waveshaperMode::kDirect;
+		bool enteringTableMode = tableMode && parameters.shaperMode == waveshaperMode::kDirect;
+		if (tableMode && (curveChanged || enteringTableMode))
+			shaperTable.build(params.waveshaper, params.saturation, params.asymmetry);
+
 		parameters = params;
 
 		AudioFilterParameters filterParams;
@@ -5974,7 +8072,11 @@ public:
 		// --- perform waveshaping
 		double output = 0.0;
 
-		if (parameters.waveshaper == distortionModel::kSoftClip)
+		if (parameters.shaperMode == waveshaperMode::kTable)
+			output = shaperTable.processAudioSample(xn);
+		else if (parameters.shaperMode == waveshaperMode::kTableADAA)
+			output = shaperTable.processAudioSampleADAA(xn);
+		else if (parameters.waveshaper == distortionModel::kSoftClip)
 			output = softClipWaveShaper(xn, parameters.saturation);
 		else if (parameters.waveshaper == distortionModel::kArcTan)
 			output = atanWaveShaper(xn, parameters.saturation);
@@ -6003,6 +8105,7 @@ protected:
 	TriodeClassAParameters parameters;	///< object parameters
 	AudioFilter outputHPF;				///< HPF to simulate output DC blocking cap
 	AudioFilter outputLSF;				///< LSF to simulate shelf caused by cathode self-biasing cap
+	WaveShaperTable shaperTable;		///< table for the current waveshaper curve
 };
 
 const unsigned int NUM_TUBES = 4;
@@ -6031,6 +8134,7 @@ struct ClassATubePreParameters
 		saturation = params.saturation;
 		asymmetry = params.asymmetry;
 		outputLevel_dB = params.outputLevel_dB;
+		shaperMode = params.shaperMode;
 
 		lowShelf_fc = params.lowShelf_fc;
 		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
@@ -6045,6 +8149,7 @@ struct ClassATubePreParameters
 	double saturation = 0.0;		///< input level in dB
 	double asymmetry = 0.0;			///< input level in dB
 	double outputLevel_dB = 0.0;	///< input level in dB
+	waveshaperMode shaperMode = waveshaperMode::kDirect; ///< triode waveshaper evaluation
 
 	// --- shelving filter params
 	double lowShelf_fc = 0.0;			///< LSF shelf frequency
@@ -6090,6 +8195,7 @@ public:
 		tubeParams.lsf_Fshelf = 88.0;
 		tubeParams.lsf_BoostCut_dB = -12.0;
 		tubeParams.waveshaper = distortionModel::kFuzzAsym;
+		tubeParams.shaperMode = parameters.shaperMode;
 
 		for (int i = 0; i < NUM_TUBES; i++)
 		{
@@ -6135,6 +8241,7 @@ public:
 		TriodeClassAParameters tubeParams = triodes[0].getParameters();
 		tubeParams.saturation = parameters.saturation;
 		tubeParams.asymmetry = parameters.asymmetry;
+		tubeParams.shaperMode = parameters.shaperMode;
 
 		for (int i = 0; i < NUM_TUBES; i++)
 			triodes[i].setParameters(tubeParams);
@@ -6148,7 +8255,7 @@ public:
 	\param xn input
 	\return the processed sample
 	*/
-	virtual double processAudioSample(double xn, int channel, double _sampleRate)
+	virtual float processAudioSample(float xn, int channel, double _sampleRate) // changed to float
 	{
 		double output1 = triodes[0].processAudioSample(xn*inputLevel, channel, _sampleRate);
 		double output2 = triodes[1].processAudioSample(output1, channel, _sampleRate);
@@ -6171,6 +8278,37 @@ protected:
 };
 
 
+// --- constants for BitCrusher
+const int BITCRUSHER_BLOCK_SIZE = 64;					///< sub-block size for processAudioBlock( ) (stack scratch buffers)
+const double BITCRUSHER_PREFILTER_RATIO = 0.45;			///< anti-aliasing LPF fc, fraction of the hold rate
+const double BITCRUSHER_PREFILTER_Q1 = 0.5412;			///< 4th order Butterworth as two 2nd order sections
+const double BITCRUSHER_PREFILTER_Q2 = 1.3066;
+
+/**
+\enum bitCrusherNoiseShaping
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to set the BitCrusher error feedback (noise shaping) filter.
+
+- enum class bitCrusherNoiseShaping { kNone, kFirstOrder, kSecondOrder };
+- kFirstOrder: noise transfer function (1 - z^-1), +6 dB/oct
+- kSecondOrder: noise transfer function (1 - z^-1)^2, +12 dB/oct
+*/
+enum class bitCrusherNoiseShaping { kNone, kFirstOrder, kSecondOrder };
+
+/**
+\enum bitCrusherBandLimit
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to set how the BitCrusher sample rate reduction (zero order hold) is band limited.
+
+- enum class bitCrusherBandLimit { kNone, kPreFilter, kPreFilterBLEP };
+- kNone: raw sample and hold; input above the hold Nyquist aliases (the classic sound)
+- kPreFilter: 4th order Butterworth LPF at 0.45 x the hold rate ahead of the hold
+- kPreFilterBLEP: pre filter, plus polyBLEP steps so the hold transitions do not alias (1 sample latency)
+*/
+enum class bitCrusherBandLimit { kNone, kPreFilter, kPreFilterBLEP };
+
 /**
 \struct BitCrusherParameters
 \ingroup FX-Objects
@@ -6192,18 +8330,33 @@ struct BitCrusherParameters
 			return *this;
 
 		quantizedBitDepth = params.quantizedBitDepth;
+		enableDither = params.enableDither;
+		noiseShaping = params.noiseShaping;
+		holdRate_Hz = params.holdRate_Hz;
+		bandLimit = params.bandLimit;
 
 		return *this;
 	}
 
 	double quantizedBitDepth = 4.0; ///< bid depth of quantizer
+	bool enableDither = false;		///< TPDF dither, +/- 1 LSB
+	bitCrusherNoiseShaping noiseShaping = bitCrusherNoiseShaping::kNone; ///< error feedback filter
+	double holdRate_Hz = 0.0;		///< sample rate reduction (zero order hold) rate; 0 or >= sample rate = off
+	bitCrusherBandLimit bandLimit = bitCrusherBandLimit::kNone; ///< band limiting of the sample rate reduction
 };
 
 /**
 \class BitCrusher
 \ingroup FX-Objects
 \brief
-The BitCrusher object implements a quantizing bitcrusher algorithm.
+The BitCrusher object implements a quantizing bitcrusher algorithm, with optional dither, noise shaping
+and sample rate reduction.
+
+- processAudioBlock( ) is the block engine; processAudioSample( ) runs it on a block of one
+- plain quantization truncates toward zero like the original per-sample version, in a branch-free loop that
+auto-vectorizes; with dither or noise shaping the quantizer rounds instead so the error is zero mean
+- noise shaping feeds the quantization error back, so that loop is serial
+- sample rate reduction holds the input at holdRate_Hz ahead of the quantizer, like a sample and hold ADC
 
 Audio I/O:
 - Processes mono input to mono output.
@@ -6219,11 +8372,29 @@ Control I/F:
 class BitCrusher : public IAudioSignalProcessor
 {
 public:
-	BitCrusher() {}		/* C-TOR */
+	BitCrusher() {
+		QL = 2.0 / (pow(2.0, parameters.quantizedBitDepth) - 1.0);
+	}		/* C-TOR */
 	~BitCrusher() {}		/* D-TOR */
 
 	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate){ return true; }
+	virtual bool reset(double _sampleRate, int channel)
+	{
+		sampleRate = _sampleRate;
+
+		preFilter[0].reset(_sampleRate, channel);
+		preFilter[1].reset(_sampleRate, channel);
+		updateHold();
+
+		holdPhase = 0.0;
+		heldValue = 0.0f;
+		lastInput = 0.0f;
+		blepPending = 0.0f;
+		shapingError[0] = 0.0f;
+		shapingError[1] = 0.0f;
+
+		return true;
+	}
 
 	/** get parameters: note use of custom structure for passing param data */
 	/**
@@ -6231,35 +8402,204 @@ public:
 	*/
 	BitCrusherParameters getParameters() { return parameters; }
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param BitCrusherParameters custom data structure
-	*/
-	void setParameters(const BitCrusherParameters& params)
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param BitCrusherParameters custom data structure
+	*/
+	void setParameters(const BitCrusherParameters& params)
+	{
+		// --- calculate and store
+		if (params.quantizedBitDepth != parameters.quantizedBitDepth)
+			QL = 2.0 / (pow(2.0, params.quantizedBitDepth) - 1.0);
+
+		bool holdChanged = params.holdRate_Hz != parameters.holdRate_Hz;
+		parameters = params;
+
+		if (holdChanged)
+			updateHold();
+	}
+
+	/** samples of delay: one with band limited (polyBLEP) steps, else none */
+	int getLatencyInSamples() { return holdIncrement > 0.0 && parameters.bandLimit == bitCrusherBandLimit::kPreFilterBLEP ? 1 : 0; }
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** perform the bitcrushing operation (see FX book for back story and details) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual float processAudioSample(float xn, int channel, double _sampleRate) // changed to float
+	{
+		float yn = 0.0f;
+		processAudioBlock(&xn, &yn, 1);
+		return yn;
+	}
+
+	/** process a block: sample rate reduction, dither, then quantization; in place is fine */
+	/**
+	\param input input samples
+	\param output output samples
+	\param numSamples number of samples
+	*/
+	void processAudioBlock(const float* input, float* output, int numSamples)
+	{
+		float held[BITCRUSHER_BLOCK_SIZE];
+		float dither[BITCRUSHER_BLOCK_SIZE];
+
+		for (int start = 0; start < numSamples; start += BITCRUSHER_BLOCK_SIZE)
+		{
+			const int count = numSamples - start < BITCRUSHER_BLOCK_SIZE ? numSamples - start : BITCRUSHER_BLOCK_SIZE;
+			const float* x = input + start;
+			float* y = output + start;
+
+			// --- sample rate reduction
+			if (holdIncrement > 0.0)
+			{
+				sampleAndHold(x, held, count);
+				x = held;
+			}
+
+			// --- TPDF dither in LSBs: sum of two uniform [-0.5, 0.5) values
+			const bool rounding = parameters.enableDither || parameters.noiseShaping != bitCrusherNoiseShaping::kNone;
+			if (rounding)
+			{
+				for (int n = 0; n < count; n++)
+				{
+					dither[n] = parameters.enableDither ? nextUniform() + nextUniform() : 0.0f;
+				}
+			}
+
+			if (parameters.noiseShaping != bitCrusherNoiseShaping::kNone)
+				quantizeShaped(x, dither, y, count);
+			else if (rounding)
+				quantizeRounded(x, dither, y, count);
+			else
+				quantizeTruncated(x, y, count);
+		}
+	}
+
+protected:
+	/** hold increment and pre filter fc for the hold rate */
+	void updateHold()
+	{
+		holdIncrement = parameters.holdRate_Hz > 0.0 && parameters.holdRate_Hz < sampleRate ? parameters.holdRate_Hz / sampleRate : 0.0;
+
+		AudioFilterParameters filterParams = preFilter[0].getParameters();
+		filterParams.algorithm = filterAlgorithm::kLPF2;
+		filterParams.fc = (float)(BITCRUSHER_PREFILTER_RATIO * (holdIncrement > 0.0 ? parameters.holdRate_Hz : 0.5 * sampleRate));
+		filterParams.Q = (float)BITCRUSHER_PREFILTER_Q1;
+		preFilter[0].setParameters(filterParams);
+		filterParams.Q = (float)BITCRUSHER_PREFILTER_Q2;
+		preFilter[1].setParameters(filterParams);
+	}
+
+	/** LCG, uniform in [-0.5, 0.5) */
+	inline float nextUniform()
+	{
+		ditherSeed = ditherSeed * 1664525u + 1013904223u;
+		return (float)(ditherSeed >> 8) * (1.0f / 16777216.0f) - 0.5f;
+	}
+
+	/** zero order hold at holdRate_Hz; a new value is taken at the exact (interpolated) crossing time */
+	void sampleAndHold(const float* input, float* output, int count)
+	{
+		const bool filtered = parameters.bandLimit != bitCrusherBandLimit::kNone;
+		const bool blep = parameters.bandLimit == bitCrusherBandLimit::kPreFilterBLEP;
+
+		for (int n = 0; n < count; n++)
+		{
+			float xn = input[n];
+			if (filtered)
+				xn = preFilter[1].processAudioSample(preFilter[0].processAudioSample(xn, 0, sampleRate), 0, sampleRate);
+
+			float step = 0.0f;
+			float t = 0.0f;
+			holdPhase += holdIncrement;
+			if (holdPhase >= 1.0)
+			{
+				holdPhase -= 1.0;
+				t = (float)(holdPhase / holdIncrement);	// samples since the crossing, [0, 1)
+
+				float newValue = xn - t * (xn - lastInput);
+				step = newValue - heldValue;
+				heldValue = newValue;
+			}
+			lastInput = xn;
+
+			if (blep)
+			{
+				// --- polyBLEP residual on the sample before and after the step; output is one sample late
+				output[n] = blepPending + step * 0.5f * t * t;
+				blepPending = heldValue - step * 0.5f * (1.0f - t) * (1.0f - t);
+			}
+			else
+				output[n] = heldValue;
+		}
+	}
+
+	/** the original quantizer: truncate toward zero */
+	void quantizeTruncated(const float* input, float* output, int count)
 	{
-		// --- calculate and store
-		if (params.quantizedBitDepth != parameters.quantizedBitDepth)
-			QL = 2.0 / (pow(2.0, params.quantizedBitDepth) - 1.0);
-
-		parameters = params;
+		const float ql = (float)QL;
+		const float invQL = (float)(1.0 / QL);
+		for (int n = 0; n < count; n++)
+		{
+			output[n] = ql * (float)(int)(input[n] * invQL);
+		}
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** round to nearest with dither (in LSBs) */
+	void quantizeRounded(const float* input, const float* dither, float* output, int count)
+	{
+		const float ql = (float)QL;
+		const float invQL = (float)(1.0 / QL);
+		for (int n = 0; n < count; n++)
+		{
+			float v = input[n] * invQL + dither[n];
+			output[n] = ql * (float)(int)(v + (v >= 0.0f ? 0.5f : -0.5f));
+		}
+	}
 
-	/** perform the bitcrushing operation (see FX book for back story and details) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** error feedback quantizer: v = x - sum(c_k * e[n-k]), e = Q(v + d) - v */
+	void quantizeShaped(const float* input, const float* dither, float* output, int count)
 	{
-		return QL*(int(xn / QL));
+		const float ql = (float)QL;
+		const float invQL = (float)(1.0 / QL);
+		const float c1 = parameters.noiseShaping == bitCrusherNoiseShaping::kSecondOrder ? 2.0f : 1.0f;
+		const float c2 = parameters.noiseShaping == bitCrusherNoiseShaping::kSecondOrder ? -1.0f : 0.0f;
+
+		float e1 = shapingError[0];
+		float e2 = shapingError[1];
+		for (int n = 0; n < count; n++)
+		{
+			float v = input[n] * invQL - c1 * e1 - c2 * e2;
+			float w = v + dither[n];
+			float q = (float)(int)(w + (w >= 0.0f ? 0.5f : -0.5f));
+			e2 = e1;
+			e1 = q - v;
+			output[n] = ql * q;
+		}
+		shapingError[0] = e1;
+		shapingError[1] = e2;
 	}
 
-protected:
 	BitCrusherParameters parameters; ///< object parameters
 	double QL = 1.0;				 ///< the quantization level
+	double sampleRate = 44100.0;	 ///< current sample rate
+
+	// --- sample rate reduction
+	AudioFilter preFilter[2];		///< 4th order anti-aliasing LPF ahead of the hold
+	double holdIncrement = 0.0;		///< hold rate / sample rate; 0 = off
+	double holdPhase = 0.0;			///< hold clock phase, [0, 1)
+	float heldValue = 0.0f;			///< current held sample
+	float lastInput = 0.0f;			///< last (filtered) input, for the crossing interpolation
+	float blepPending = 0.0f;		///< next output with its polyBLEP correction (one sample late)
+
+	// --- dither and noise shaping
+	uint32_t ditherSeed = 22222;	///< LCG state
+	float shapingError[2] = { 0.0f, 0.0f }; ///< last two quantization errors, in LSBs
 };
 
 
@@ -8004,6 +10344,348 @@ private:
 	double A3 = 0.0;	///< A3 coefficient value
 };
 
+// ------------------------------------------------------------------ //
+// --- STATIC (COMPILE-TIME) WDF TREES ------------------------------ //
+// ------------------------------------------------------------------ //
+//
+// The adaptors above are wired at run time through IComponentAdaptor pointers, so every port
+// of every adaptor costs a virtual call per sample. The templates below describe the same ladder
+// as a type: each adaptor holds its component and its downstream adaptor BY VALUE, e.g.
+//
+//		WdfStaticSeriesAdaptor<WdfInductor,
+//			WdfStaticParallelAdaptor<WdfCapacitor,
+//				WdfStaticSeriesTerminatedAdaptor<WdfInductor> > >
+//
+// Calls on member objects bind statically (even to the virtual component functions), so the
+// compiler sees the whole forward/backward scattering pass and inlines it into straight-line code.
+// Any WDF component or combo component above (WdfResistor ... WdfParallelRC) can be used as the
+// Component; the scattering equations are the same as the run-time adaptors'.
+
+/**
+\class WdfStaticAdaptorBase
+\ingroup WDF-Objects
+\brief
+The WdfStaticAdaptorBase object holds the component (port 3) and the port resistances for the
+compile-time WDF adaptors.
+*/
+template <class Component>
+class WdfStaticAdaptorBase
+{
+public:
+	/** set the input (source) resistance for the input (root) adaptor */
+	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
+
+	/** the component connected to port 3 */
+	Component& getComponent() { return component; }
+
+	/** set value of single-component adaptor */
+	void setComponentValue(double _componentValue) { component.setComponentValue(_componentValue); }
+
+	/** set LC value of multi-component adaptor */
+	void setComponentValue_LC(double componentValue_L, double componentValue_C) { component.setComponentValue_LC(componentValue_L, componentValue_C); }
+
+	/** set RL value of multi-component adaptor */
+	void setComponentValue_RL(double componentValue_R, double componentValue_L) { component.setComponentValue_RL(componentValue_R, componentValue_L); }
+
+	/** set RC value of multi-component adaptor */
+	void setComponentValue_RC(double componentValue_R, double componentValue_C) { component.setComponentValue_RC(componentValue_R, componentValue_C); }
+
+protected:
+	Component component;				///< component at port 3, held by value
+	double R1 = 0.0;					///< input port resistance
+	double R2 = 0.0;					///< output port resistance
+	double sourceResistance = 600.0;	///< source impedance (root adaptor only); OK for this to be set to 0.0 for Rs = 0
+};
+
+/**
+\class WdfStaticSeriesAdaptor
+\ingroup WDF-Objects
+\brief
+Compile-time version of WdfSeriesAdaptor (series reflection-free adaptor); Downstream is the adaptor at port 2.
+*/
+template <class Component, class Downstream>
+class WdfStaticSeriesAdaptor : public WdfStaticAdaptorBase<Component>
+{
+public:
+	/** the adaptor connected to port 2 */
+	Downstream& getDownstream() { return downstream; }
+
+	/** reset the components in the chain (flush state registers) */
+	void reset(double _sampleRate)
+	{
+		this->component.reset(_sampleRate);
+		downstream.reset(_sampleRate);
+	}
+
+	/** initialize the chain of adaptors from this (root) adaptor with the source resistance */
+	void initializeAdaptorChain() { initialize(this->sourceResistance); }
+
+	/** initialize adaptor with input resistance; R2 = R1 + component (series) */
+	void initialize(double _R1)
+	{
+		this->R1 = _R1;
+		double componentResistance = this->component.getComponentResistance();
+		B = this->R1 / (this->R1 + componentResistance);
+		this->R2 = this->R1 + componentResistance;
+		downstream.initialize(this->R2);
+	}
+
+	/** scatter incident wave in1: forward to port 2, then back; returns the reflected wave out1 */
+	inline double setInput1(double in1)
+	{
+		double N2 = this->component.getOutput();
+		double out2 = -(in1 + N2);
+
+		// --- downstream returns its reflected wave, our in2
+		double in2 = downstream.setInput1(out2);
+
+		double N1 = -(in1 - B*(in1 + N2 + in2) + in2);
+		double out1 = in1 - B*(N2 + in2);
+		this->component.setInput(N1);
+		return out1;
+	}
+
+	/** y(n), from the terminated adaptor at the end of the chain */
+	inline double getTerminalOutput() { return downstream.getTerminalOutput(); }
+
+	/** push x(n) through the tree and return y(n) */
+	inline double processAudioSample(double xn)
+	{
+		setInput1(xn);
+		return getTerminalOutput();
+	}
+
+protected:
+	Downstream downstream;	///< adaptor at port 2, held by value
+	double B = 0.0;			///< B coefficient value
+};
+
+/**
+\class WdfStaticParallelAdaptor
+\ingroup WDF-Objects
+\brief
+Compile-time version of WdfParallelAdaptor (parallel reflection-free adaptor); Downstream is the adaptor at port 2.
+*/
+template <class Component, class Downstream>
+class WdfStaticParallelAdaptor : public WdfStaticAdaptorBase<Component>
+{
+public:
+	/** the adaptor connected to port 2 */
+	Downstream& getDownstream() { return downstream; }
+
+	/** reset the components in the chain (flush state registers) */
+	void reset(double _sampleRate)
+	{
+		this->component.reset(_sampleRate);
+		downstream.reset(_sampleRate);
+	}
+
+	/** initialize the chain of adaptors from this (root) adaptor with the source resistance */
+	void initializeAdaptorChain() { initialize(this->sourceResistance); }
+
+	/** initialize adaptor with input resistance; R2 = 1.0/(sum of admittances) */
+	void initialize(double _R1)
+	{
+		this->R1 = _R1;
+		double G1 = 1.0 / this->R1;
+		double componentConductance = this->component.getComponentConductance();
+		A = G1 / (G1 + componentConductance);
+		this->R2 = 1.0 / (G1 + componentConductance);
+		downstream.initialize(this->R2);
+	}
+
+	/** scatter incident wave in1: forward to port 2, then back; returns the reflected wave out1 */
+	inline double setInput1(double in1)
+	{
+		double N2 = this->component.getOutput();
+		double out2 = N2 - A*(-in1 + N2);
+
+		// --- downstream returns its reflected wave, our in2
+		double in2 = downstream.setInput1(out2);
+
+		double N1 = in2 - A*(-in1 + N2);
+		double out1 = -in1 + N2 + N1;
+		this->component.setInput(N1);
+		return out1;
+	}
+
+	/** y(n), from the terminated adaptor at the end of the chain */
+	inline double getTerminalOutput() { return downstream.getTerminalOutput(); }
+
+	/** push x(n) through the tree and return y(n) */
+	inline double processAudioSample(double xn)
+	{
+		setInput1(xn);
+		return getTerminalOutput();
+	}
+
+protected:
+	Downstream downstream;	///< adaptor at port 2, held by value
+	double A = 0.0;			///< A coefficient value
+};
+
+/**
+\class WdfStaticSeriesTerminatedAdaptor
+\ingroup WDF-Objects
+\brief
+Compile-time version of WdfSeriesTerminatedAdaptor; ends a static WDF chain.
+*/
+template <class Component>
+class WdfStaticSeriesTerminatedAdaptor : public WdfStaticAdaptorBase<Component>
+{
+public:
+	/** set the terminal (load) resistance */
+	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+
+	/** set the terminal (load) resistance as open circuit */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true)
+	{
+		openTerminalResistance = _openTerminalResistance;
+		terminalResistance = 1.0e+34; // avoid /0.0
+	}
+
+	/** reset the component (flush state register) */
+	void reset(double _sampleRate) { this->component.reset(_sampleRate); }
+
+	/** initialize this adaptor alone, as the root, with the source resistance */
+	void initializeAdaptorChain() { initialize(this->sourceResistance); }
+
+	/** initialize adaptor with input resistance */
+	void initialize(double _R1)
+	{
+		this->R1 = _R1;
+		double componentResistance = this->component.getComponentResistance();
+		B1 = (2.0*this->R1) / (this->R1 + componentResistance + terminalResistance);
+		B3 = (2.0*terminalResistance) / (this->R1 + componentResistance + terminalResistance);
+		this->R2 = this->R1 + componentResistance;
+	}
+
+	/** scatter incident wave in1; stores y(n) and returns the reflected wave out1 */
+	inline double setInput1(double in1)
+	{
+		double N2 = this->component.getOutput();
+		double N3 = in1 + N2;
+
+		out2 = -B3*N3;
+		double out1 = in1 - B1*N3;
+		double N1 = -(out1 + out2 + N3);
+		this->component.setInput(N1);
+		return out1;
+	}
+
+	/** y(n) */
+	inline double getTerminalOutput() { return out2; }
+
+	/** push x(n) through the adaptor and return y(n) */
+	inline double processAudioSample(double xn)
+	{
+		setInput1(xn);
+		return out2;
+	}
+
+protected:
+	double out2 = 0.0;						///< y(n)
+	double B1 = 0.0;						///< B1 coefficient value
+	double B3 = 0.0;						///< B3 coefficient value
+	double terminalResistance = 600.0;		///< value of terminal (load) resistance
+	bool openTerminalResistance = false;	///< flag for open circuit load
+};
+
+/**
+\class WdfStaticParallelTerminatedAdaptor
+\ingroup WDF-Objects
+\brief
+Compile-time version of WdfParallelTerminatedAdaptor; ends a static WDF chain.
+*/
+template <class Component>
+class WdfStaticParallelTerminatedAdaptor : public WdfStaticAdaptorBase<Component>
+{
+public:
+	/** set the terminal (load) resistance */
+	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+
+	/** set the terminal (load) resistance as open circuit */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true)
+	{
+		openTerminalResistance = _openTerminalResistance;
+		terminalResistance = 1.0e+34; // avoid /0.0
+	}
+
+	/** reset the component (flush state register) */
+	void reset(double _sampleRate) { this->component.reset(_sampleRate); }
+
+	/** initialize this adaptor alone, as the root, with the source resistance */
+	void initializeAdaptorChain() { initialize(this->sourceResistance); }
+
+	/** initialize adaptor with input resistance */
+	void initialize(double _R1)
+	{
+		this->R1 = _R1;
+		double G1 = 1.0 / this->R1;
+		if (terminalResistance <= 0.0)
+			terminalResistance = 1e-15;
+
+		double G2 = 1.0 / terminalResistance;
+		double componentConductance = this->component.getComponentConductance();
+		A1 = 2.0*G1 / (G1 + componentConductance + G2);
+		A3 = openTerminalResistance ? 0.0 : 2.0*G2 / (G1 + componentConductance + G2);
+		this->R2 = 1.0 / (G1 + componentConductance);
+	}
+
+	/** scatter incident wave in1; stores y(n) and returns the reflected wave out1 */
+	inline double setInput1(double in1)
+	{
+		double N2 = this->component.getOutput();
+		double N1 = -A1*(-in1 + N2) + N2 - A3*N2;
+		double out1 = -in1 + N2 + N1;
+
+		out2 = N2 + N1;
+		this->component.setInput(N1);
+		return out1;
+	}
+
+	/** y(n) */
+	inline double getTerminalOutput() { return out2; }
+
+	/** push x(n) through the adaptor and return y(n) */
+	inline double processAudioSample(double xn)
+	{
+		setInput1(xn);
+		return out2;
+	}
+
+protected:
+	double out2 = 0.0;						///< y(n)
+	double A1 = 0.0;						///< A1 coefficient value
+	double A3 = 0.0;						///< A3 coefficient value
+	double terminalResistance = 600.0;		///< value of terminal (load) resistance
+	bool openTerminalResistance = false;	///< flag for open circuit load
+};
+
+/**
+\struct WdfStaticStage
+\ingroup WDF-Objects
+\brief
+Compile-time access to the adaptor at a given depth of a static WDF chain, e.g.
+WdfStaticStage<2>::get(tree).setComponentValue(x) sets the component of the third adaptor.
+*/
+template <unsigned int Stage>
+struct WdfStaticStage
+{
+	template <class Adaptor>
+	static auto get(Adaptor& adaptor) -> decltype(WdfStaticStage<Stage - 1>::get(adaptor.getDownstream()))
+	{
+		return WdfStaticStage<Stage - 1>::get(adaptor.getDownstream());
+	}
+};
+
+template <>
+struct WdfStaticStage<0>
+{
+	template <class Adaptor>
+	static Adaptor& get(Adaptor& adaptor) { return adaptor; }
+};
+
 // ------------------------------------------------------------------------------ //
 // --- WDF Ladder Filter Design  Examples --------------------------------------- //
 // ------------------------------------------------------------------------------ //
@@ -8223,6 +10905,97 @@ protected:
 	double sampleRate = 1.0;			///< stored sample rate
 };
 
+/**
+\class WDFStaticTunableButterLPF3
+\ingroup WDF-Objects
+\brief
+The WDFStaticTunableButterLPF3 object implements the WDFTunableButterLPF3 ladder as a static WDF tree;
+same response, with the scattering inlined (no virtual calls per sample).
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- setUsePostWarping(bool b) to enable/disable warping (see book)
+- setFilterFc(double fc_Hz) to set the tunable fc value
+*/
+class WDFStaticTunableButterLPF3 : public IAudioSignalProcessor
+{
+public:
+	WDFStaticTunableButterLPF3(void) { createWDF(); }	/* C-TOR */
+	~WDFStaticTunableButterLPF3(void) {}	/* D-TOR */
+
+	// --- Series(L1) -> Parallel(C1) -> Series terminated(L2)
+	typedef WdfStaticSeriesAdaptor<WdfInductor,
+				WdfStaticParallelAdaptor<WdfCapacitor,
+					WdfStaticSeriesTerminatedAdaptor<WdfInductor> > > LadderType;
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate, int channel)
+	{
+		sampleRate = _sampleRate;
+
+		// --- reset WDF components (flush state registers), then intialize the chain of adapters
+		ladder.reset(_sampleRate);
+		ladder.initializeAdaptorChain();
+		return true;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual float processAudioSample(float xn, int channel, double _sampleRate)
+	{
+		return (float)ladder.processAudioSample(xn);
+	}
+
+	/** create the filter structure; may be called more than once */
+	void createWDF()
+	{
+		// --- init to normalized values fc = 1Hz
+		WdfStaticStage<0>::get(ladder).setComponentValue(L1_norm);
+		WdfStaticStage<1>::get(ladder).setComponentValue(C1_norm);
+		WdfStaticStage<2>::get(ladder).setComponentValue(L2_norm);
+
+		// --- set source and terminal resistance
+		ladder.setSourceResistance(600.0); // --- Rs = 600
+		WdfStaticStage<2>::get(ladder).setTerminalResistance(600.0); // --- Rload = 600
+	}
+
+	/** parameter setter for warping */
+	void setUsePostWarping(bool b) { useFrequencyWarping = b; }
+
+	/** parameter setter for fc; re-initializes the adaptor chain for the new component values */
+	void setFilterFc(double fc_Hz)
+	{
+		if (useFrequencyWarping)
+		{
+			double arg = (kPi*fc_Hz) / sampleRate;
+			fc_Hz = fc_Hz*(tan(arg) / arg);
+		}
+
+		WdfStaticStage<0>::get(ladder).setComponentValue(L1_norm / fc_Hz);
+		WdfStaticStage<1>::get(ladder).setComponentValue(C1_norm / fc_Hz);
+		WdfStaticStage<2>::get(ladder).setComponentValue(L2_norm / fc_Hz);
+		ladder.initializeAdaptorChain();
+	}
+
+protected:
+	LadderType ladder;	///< the whole ladder, by value
+
+	double L1_norm = 95.493;		// 95.5 mH
+	double C1_norm = 530.516e-6;	// 0.53 uF
+	double L2_norm = 95.493;		// 95.5 mH
+
+	bool useFrequencyWarping = false;	///< flag for freq warping
+	double sampleRate = 1.0;			///< stored sample rate
+};
+
 /**
 \class WDFBesselBSF3
 \ingroup WDF-Objects